@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @brief Counting the heap allocations made by each example
+ *
+ * Tracking is opt-in: define CPPSPEC_TRACK_ALLOCATIONS (for the whole spec
+ * binary) and CPPSPEC_MAIN replaces the global `operator new` and `operator
+ * delete` with ones that charge every allocation to the example running on
+ * the allocating thread.
+ *
+ * An example that doesn't free everything it allocated is only flagged, as
+ * memory kept on purpose (in statics or caches) can't be told apart from a
+ * leak, unless the run fails on leaks (see Runner::set_fail_on_leaks).
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <new>
+#include <string>
+
+namespace CppSpec {
+
+/**
+ * @brief The heap allocations made while an example ran, and how much of
+ * that memory it didn't free again
+ */
+struct AllocationStats {
+  std::uint64_t allocations = 0;
+  std::uint64_t bytes = 0;
+  std::int64_t live_allocations = 0;
+  std::int64_t live_bytes = 0;
+
+  [[nodiscard]] bool leaked() const noexcept { return live_bytes > 0; }
+  [[nodiscard]] std::string to_string() const {
+    return std::format("{} allocations, {} bytes, {} bytes leaked", allocations, bytes, live_bytes);
+  }
+};
+
+namespace Allocations {
+
+#ifdef CPPSPEC_TRACK_ALLOCATIONS
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+// Where allocations on this thread are counted, if anywhere
+inline thread_local AllocationStats* current = nullptr;
+// Set while the framework itself allocates, e.g. to record a Result
+inline thread_local bool paused = false;
+
+/**
+ * @brief Counts the allocations made on this thread into `stats` until it
+ * goes out of scope
+ */
+class Scope {
+  AllocationStats* previous_;
+
+ public:
+  explicit Scope(AllocationStats& stats) noexcept : previous_(current) { current = &stats; }
+  ~Scope() { current = previous_; }
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+};
+
+/**
+ * @brief Leaves the allocations made on this thread uncounted until it goes
+ * out of scope
+ */
+class Pause {
+  bool was_paused_;
+
+ public:
+  Pause() noexcept : was_paused_(paused) { paused = true; }
+  ~Pause() { paused = was_paused_; }
+  Pause(const Pause&) = delete;
+  Pause& operator=(const Pause&) = delete;
+};
+
+/*
+ * Every block is prefixed with the size that was asked for and the stats it
+ * was counted in, so that freeing it can be charged back to the same
+ * example. The prefix keeps the block aligned for any fundamental type.
+ */
+struct Header {
+  std::size_t size;
+  AllocationStats* owner;
+};
+constexpr std::size_t header_size =
+    (sizeof(Header) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+inline void* allocate(std::size_t size) noexcept {
+  void* block = std::malloc(size + header_size);
+  if (block == nullptr) {
+    return nullptr;
+  }
+  auto* header = static_cast<Header*>(block);
+  header->size = size;
+  header->owner = paused ? nullptr : current;
+  if (header->owner != nullptr) {
+    header->owner->allocations += 1;
+    header->owner->bytes += size;
+    header->owner->live_allocations += 1;
+    header->owner->live_bytes += static_cast<std::int64_t>(size);
+  }
+  return static_cast<char*>(block) + header_size;
+}
+
+inline void deallocate(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto* header = reinterpret_cast<Header*>(static_cast<char*>(ptr) - header_size);
+  // Only the example that allocated a block is still counting into its owner
+  if (header->owner != nullptr && header->owner == current) {
+    header->owner->live_allocations -= 1;
+    header->owner->live_bytes -= static_cast<std::int64_t>(header->size);
+  }
+  std::free(header);
+}
+
+inline void* allocate_or_throw(std::size_t size) {
+  while (true) {
+    if (void* ptr = allocate(size)) {
+      return ptr;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc{};
+    }
+    handler();
+  }
+}
+
+}  // namespace Allocations
+}  // namespace CppSpec
+
+/*
+ * The replacement allocation functions, which CPPSPEC_MAIN defines (once per
+ * binary) when CPPSPEC_TRACK_ALLOCATIONS is defined. Over-aligned allocations
+ * are left to the standard library and aren't counted.
+ */
+#ifdef CPPSPEC_TRACK_ALLOCATIONS
+#define CPPSPEC_ALLOCATION_FUNCTIONS                                                                              \
+  void* operator new(std::size_t size) { return CppSpec::Allocations::allocate_or_throw(size); }               \
+  void* operator new[](std::size_t size) { return CppSpec::Allocations::allocate_or_throw(size); }             \
+  void* operator new(std::size_t size, const std::nothrow_t&) noexcept {                                       \
+    return CppSpec::Allocations::allocate(size);                                                               \
+  }                                                                                                            \
+  void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {                                     \
+    return CppSpec::Allocations::allocate(size);                                                               \
+  }                                                                                                            \
+  void operator delete(void* ptr) noexcept { CppSpec::Allocations::deallocate(ptr); }                          \
+  void operator delete[](void* ptr) noexcept { CppSpec::Allocations::deallocate(ptr); }                        \
+  void operator delete(void* ptr, std::size_t) noexcept { CppSpec::Allocations::deallocate(ptr); }             \
+  void operator delete[](void* ptr, std::size_t) noexcept { CppSpec::Allocations::deallocate(ptr); }           \
+  void operator delete(void* ptr, const std::nothrow_t&) noexcept { CppSpec::Allocations::deallocate(ptr); }   \
+  void operator delete[](void* ptr, const std::nothrow_t&) noexcept { CppSpec::Allocations::deallocate(ptr); }
+#else
+#define CPPSPEC_ALLOCATION_FUNCTIONS
+#endif
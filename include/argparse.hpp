@@ -1,11 +1,22 @@
 #pragma once
 
 #include <argparse/argparse.hpp>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
+#include <list>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 #include "formatters/junit_xml.hpp"
 #include "formatters/progress.hpp"
+#include "formatters/report.hpp"
 #include "formatters/tap.hpp"
 #include "formatters/verbose.hpp"
 #include "runner.hpp"
@@ -22,6 +33,49 @@ inline std::string file_name(std::string_view path) {
   return std::string{file};
 }
 
+/**
+ * @brief Split a `FILE:LINE` location into its parts.
+ * @throws std::invalid_argument if it isn't of that form
+ */
+inline std::pair<std::string, std::uint_least32_t> parse_location(std::string_view location) {
+  auto colon = location.rfind(':');
+  std::uint_least32_t line = 0;
+  if (colon != std::string_view::npos && colon != 0) {
+    const char* first = location.data() + colon + 1;
+    const char* last = location.data() + location.size();
+    auto [ptr, ec] = std::from_chars(first, last, line);
+    if (ec == std::errc{} && ptr == last && first != last) {
+      return {std::string{location.substr(0, colon)}, line};
+    }
+  }
+  throw std::invalid_argument{"expected a location of the form FILE:LINE, got: " + std::string{location}};
+}
+
+/**
+ * @brief Parse an `--order` of `defined`, `random` or `random:SEED`.
+ * @return the seed to shuffle with, or nothing for the defined order
+ * @throws std::invalid_argument if it isn't one of those
+ */
+inline std::optional<std::uint64_t> parse_order(std::string_view order) {
+  if (order == "defined") {
+    return std::nullopt;
+  }
+  if (order == "random") {
+    std::random_device device;
+    return (std::uint64_t{device()} << 32) | device();
+  }
+  if (order.starts_with("random:")) {
+    std::uint64_t seed = 0;
+    const char* first = order.data() + 7;
+    const char* last = order.data() + order.size();
+    auto [ptr, ec] = std::from_chars(first, last, seed);
+    if (ec == std::errc{} && ptr == last && first != last) {
+      return seed;
+    }
+  }
+  throw std::invalid_argument{"expected an order of defined, random or random:SEED, got: " + std::string{order}};
+}
+
 inline Runner parse(int argc, char** const argv) {
   std::filesystem::path executable_path = argv[0];
   std::string executable_name = executable_path.filename().string();
@@ -34,7 +88,69 @@ inline Runner parse(int argc, char** const argv) {
       .help("set the output format");
 
   program.add_argument("--output-junit").help("output JUnit XML to the specified file").default_value(std::string{});
+  program.add_argument("--report")
+      .help("write a machine-readable report of the results to FILE, for cppspec-run")
+      .default_value(std::string{});
   program.add_argument("--verbose").help("increase output verbosity").flag();
+  program.add_argument("-j", "--jobs")
+      .default_value(std::size_t{1})
+      .scan<'u', std::size_t>()
+      .help("run up to N specs at the same time (0 uses every hardware thread)");
+  program.add_argument("--isolate")
+      .help("run each spec in its own process, up to --jobs at a time, so crashes are reported as errors")
+      .flag();
+  program.add_argument("--timeout")
+      .default_value(0.0)
+      .scan<'g', double>()
+      .help("report examples that run for longer than SECONDS as errors (0 for no limit)");
+  program.add_argument("--fail-fast")
+      .default_value(std::size_t{0})
+      .implicit_value(std::size_t{1})
+      .nargs(0, 1)
+      .scan<'u', std::size_t>()
+      .help("stop starting new examples once N of them have failed (1 if N isn't given)");
+  program.add_argument("--fail-on-leaks")
+      .help("fail examples that don't free what they allocate, when built with CPPSPEC_TRACK_ALLOCATIONS")
+      .flag();
+  program.add_argument("--order")
+      .default_value(std::string{"defined"})
+      .help("run examples in the order they're defined, or shuffled with 'random' or 'random:SEED'");
+  program.add_argument("-e", "--example")
+      .append()
+      .help("only run examples whose full description (or FILE:LINE, if unnamed) matches this regular expression");
+  program.add_argument("--location")
+      .append()
+      .help("only run the example (or the examples in the describe/context) declared at FILE:LINE");
+  program.add_argument("--failures-file")
+      .default_value(std::string{})
+      .help("record which examples failed in FILE, and which passed since");
+  program.add_argument("--only-failures")
+      .help("only run the examples that failed last time, as recorded in --failures-file")
+      .flag();
+  program.add_argument("--result-cache")
+      .default_value(std::string{})
+      .help("cache the results of passing runs in FILE, and replay them until the spec binary changes");
+  program.add_argument("--profile")
+      .default_value(std::size_t{0})
+      .implicit_value(std::size_t{10})
+      .nargs(0, 1)
+      .scan<'u', std::size_t>()
+      .help("report the N slowest examples and describes (10 if N isn't given)");
+  program.add_argument("--shard-index")
+      .default_value(std::size_t{0})
+      .scan<'u', std::size_t>()
+      .help("only run the examples in shard I (counting from 0)");
+  program.add_argument("--shard-count")
+      .default_value(std::size_t{1})
+      .scan<'u', std::size_t>()
+      .help("split the examples into N shards");
+  program.add_argument("--shard-by")
+      .default_value(std::string{"hash"})
+      .choices("hash", "timings")
+      .help("assign examples to shards by hash, or so that shards take about as long as each other");
+  program.add_argument("--timings-file")
+      .default_value(std::string{})
+      .help("keep the runtime of every example in FILE, for --shard-by timings");
 
   try {
     program.parse_args(argc, argv);
@@ -59,13 +175,84 @@ inline Runner parse(int argc, char** const argv) {
     std::exit(-1);
   }
 
+  std::list<std::shared_ptr<Formatters::BaseFormatter>> formatters{formatter};
   auto junit_output_filepath = program.get<std::string>("--output-junit");
+  // The files outlive the Runner, as JUnitXML only writes out when it's destroyed
   if (!junit_output_filepath.empty()) {
-    // open file stream
-    auto* file_stream = new std::ofstream(junit_output_filepath);
-    auto junit_output = std::make_shared<Formatters::JUnitXML>(*file_stream, false);
-    return Runner{formatter, junit_output};
+    static std::ofstream junit_file;
+    junit_file = std::ofstream{junit_output_filepath};
+    formatters.push_back(std::make_shared<Formatters::JUnitXML>(junit_file, false));
+  }
+  if (auto report_filepath = program.get<std::string>("--report"); !report_filepath.empty()) {
+    static std::ofstream report_file;
+    report_file = std::ofstream{report_filepath, std::ios::binary};
+    formatters.push_back(std::make_shared<Formatters::Report>(report_file));
+  }
+  Runner runner{std::move(formatters)};
+
+  runner.set_jobs(program.get<std::size_t>("--jobs"));
+  runner.set_isolated(program["--isolate"] == true);
+  runner.set_fail_fast(program.get<std::size_t>("--fail-fast"));
+  runner.set_fail_on_leaks(program["--fail-on-leaks"] == true);
+  // Keep machine-readable output on stdout parseable
+  bool machine_readable = std::dynamic_pointer_cast<Formatters::TAP>(formatter) != nullptr ||
+                          std::dynamic_pointer_cast<Formatters::JUnitXML>(formatter) != nullptr;
+  runner.set_profile(program.get<std::size_t>("--profile"), machine_readable ? std::cerr : std::cout);
+  if (auto timeout = program.get<double>("--timeout"); timeout > 0) {
+    runner.set_timeout(std::chrono::duration<double>{timeout});
+  }
+  auto patterns = program.present<std::vector<std::string>>("--example").value_or(std::vector<std::string>{});
+  auto locations = program.present<std::vector<std::string>>("--location").value_or(std::vector<std::string>{});
+  try {
+    for (const auto& pattern : patterns) {
+      runner.add_example_filter(pattern);
+    }
+    for (const auto& location : locations) {
+      auto [file, line] = parse_location(location);
+      runner.add_location_filter(std::move(file), line);
+    }
+    if (auto seed = parse_order(program.get<std::string>("--order"))) {
+      runner.set_random_order(*seed);
+    }
+  } catch (const std::exception& err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    std::exit(1);
+  }
+  runner.set_failures_file(program.get<std::string>("--failures-file"));
+  if (auto cache = program.get<std::string>("--result-cache"); !cache.empty()) {
+    // argv[0] may have been found through PATH, but /proc/self/exe is always this binary
+    std::filesystem::path self = std::filesystem::exists("/proc/self/exe") ? "/proc/self/exe" : executable_path;
+    if (auto build_id = ResultCache::build_id(self)) {
+      runner.set_result_cache(cache, *build_id);
+    } else {
+      std::cerr << "Can't read " << self.string() << " to identify its build; not caching results" << std::endl;
+    }
+  }
+  if (program["--only-failures"] == true) {
+    if (runner.get_failures_file().empty()) {
+      std::cerr << "--only-failures needs a --failures-file to read them from" << std::endl;
+      std::cerr << program;
+      std::exit(1);
+    }
+    runner.set_only_failures(true);
+  }
+  runner.set_timings_file(program.get<std::string>("--timings-file"));
+  if (program.get<std::string>("--shard-by") == "timings") {
+    if (runner.get_timings_file().empty()) {
+      std::cerr << "--shard-by timings needs a --timings-file to read them from" << std::endl;
+      std::cerr << program;
+      std::exit(1);
+    }
+    runner.set_shard_by_timings(true);
+  }
+  try {
+    runner.set_shard(program.get<std::size_t>("--shard-index"), program.get<std::size_t>("--shard-count"));
+  } catch (const std::out_of_range& err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    std::exit(1);
   }
-  return Runner{formatter};
+  return runner;
 }
 }  // namespace CppSpec
@@ -0,0 +1,288 @@
+/**
+ * @file
+ * @brief Coroutine support for asynchronous examples
+ */
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef CPPSPEC_SEMIHOSTED
+#include <thread>
+#endif
+
+#include "let.hpp"
+
+namespace CppSpec {
+
+/**
+ * @brief The return type of an asynchronous `it` block, or of any coroutine
+ * it awaits.
+ *
+ * A Task doesn't start until it is awaited (or scheduled on an EventLoop),
+ * and resumes whoever awaited it once it's done. An exception thrown inside
+ * is rethrown to the awaiter.
+ *
+ * @code
+ *   it("fetches a page", _async {
+ *     auto page = co_await CppSpec::wait(std::async(fetch, "example.com"));
+ *     expect(page).to_start_with("<html>");
+ *   });
+ * @endcode
+ */
+class Task {
+ public:
+  struct promise_type {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr exception;
+
+    Task get_return_object() noexcept { return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    auto final_suspend() noexcept {
+      struct Resume {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> done) noexcept {
+          return done.promise().continuation;
+        }
+        void await_resume() noexcept {}
+      };
+      return Resume{};
+    }
+
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  [[nodiscard]] Handle handle() const noexcept { return handle_; }
+  [[nodiscard]] bool done() const noexcept { return !handle_ || handle_.done(); }
+
+  /*--------- Awaiting a Task runs it -------------*/
+
+  bool await_ready() const noexcept { return done(); }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    handle_.promise().continuation = awaiting;
+    return handle_;
+  }
+  void await_resume() const {
+    if (handle_ && handle_.promise().exception) {
+      std::rethrow_exception(handle_.promise().exception);
+    }
+  }
+
+ private:
+  explicit Task(Handle handle) noexcept : handle_(handle) {}
+  Handle handle_;
+};
+
+/** @brief An `it` body that is a coroutine, given the `it` it belongs to */
+template <typename F, typename It>
+concept async_block = std::same_as<std::invoke_result_t<F&, It&>, Task>;
+
+/**
+ * @brief A single-threaded loop that resumes suspended coroutines once
+ * whatever they are waiting for is ready.
+ *
+ * Every resumption restores the LetFrame that was installed when the
+ * coroutine suspended, so interleaved examples keep their own `let` values.
+ */
+class EventLoop {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+ private:
+  struct Resumption {
+    std::coroutine_handle<> handle;
+    LetFrame* lets;
+  };
+
+  std::deque<Resumption> ready_;
+  std::multimap<Clock::time_point, Resumption> timers_;
+  std::vector<std::pair<std::function<bool()>, Resumption>> polls_;
+
+  static EventLoop*& current_loop() noexcept {
+    thread_local EventLoop* loop = nullptr;
+    return loop;
+  }
+
+  static void resume(const Resumption& resumption) {
+    std::optional<LetFrame::Scope> scope;
+    if (resumption.lets != nullptr) {
+      scope.emplace(*resumption.lets);
+    }
+    resumption.handle.resume();
+  }
+
+  void wait_for_work();
+
+ public:
+  /** @brief The loop running on this thread, if any */
+  static EventLoop* current() noexcept { return current_loop(); }
+
+  /** @brief Resume `handle` as soon as possible */
+  void schedule(std::coroutine_handle<> handle) { ready_.push_back({handle, LetFrame::current()}); }
+
+  /** @brief Resume `handle` once `time` has passed */
+  void schedule_at(Clock::time_point time, std::coroutine_handle<> handle) {
+    timers_.emplace(time, Resumption{handle, LetFrame::current()});
+  }
+
+  /** @brief Resume `handle` once `is_ready` returns true, checking on every turn of the loop */
+  void schedule_when(std::function<bool()> is_ready, std::coroutine_handle<> handle) {
+    polls_.emplace_back(std::move(is_ready), Resumption{handle, LetFrame::current()});
+  }
+
+  void run();
+};
+
+/**
+ * @brief Resume coroutines until none of them are waiting for anything.
+ */
+inline void EventLoop::run() {
+  EventLoop* previous = current_loop();
+  current_loop() = this;
+
+  while (!ready_.empty() || !timers_.empty() || !polls_.empty()) {
+    auto now = Clock::now();
+    while (!timers_.empty() && timers_.begin()->first <= now) {
+      ready_.push_back(timers_.begin()->second);
+      timers_.erase(timers_.begin());
+    }
+    for (auto poll = polls_.begin(); poll != polls_.end();) {
+      if (poll->first()) {
+        ready_.push_back(poll->second);
+        poll = polls_.erase(poll);
+      } else {
+        ++poll;
+      }
+    }
+
+    if (ready_.empty()) {
+      wait_for_work();
+      continue;
+    }
+
+    // Only run what's ready now, so that a coroutine that keeps yielding
+    // doesn't stop timers and polls from being checked.
+    std::deque<Resumption> batch = std::exchange(ready_, {});
+    for (const Resumption& resumption : batch) {
+      resume(resumption);
+    }
+  }
+
+  current_loop() = previous;
+}
+
+/**
+ * @brief Sleep until the next timer is due, or briefly when polling.
+ */
+inline void EventLoop::wait_for_work() {
+#ifndef CPPSPEC_SEMIHOSTED
+  using namespace std::chrono_literals;
+  Clock::time_point until = Clock::now() + 1ms;
+  if (polls_.empty() && !timers_.empty()) {
+    until = timers_.begin()->first;
+  } else if (!timers_.empty()) {
+    until = std::min(until, timers_.begin()->first);
+  }
+  std::this_thread::sleep_until(until);
+#endif
+}
+
+/*>>>>>>>>>>>>>>>>>>>> Awaitables <<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+struct SleepAwaiter {
+  EventLoop::Clock::time_point until;
+
+  [[nodiscard]] bool await_ready() const noexcept { return EventLoop::Clock::now() >= until; }
+  void await_suspend(std::coroutine_handle<> handle) const { EventLoop::current()->schedule_at(until, handle); }
+  void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Suspend the calling coroutine for (at least) `duration`, letting
+ * other examples run in the meantime.
+ */
+template <class Rep, class Period>
+SleepAwaiter sleep_for(std::chrono::duration<Rep, Period> duration) {
+  return {EventLoop::Clock::now() + std::chrono::duration_cast<EventLoop::Clock::duration>(duration)};
+}
+
+struct YieldAwaiter {
+  [[nodiscard]] bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle) const { EventLoop::current()->schedule(handle); }
+  void await_resume() const noexcept {}
+};
+
+/** @brief Let every other ready coroutine run before continuing. */
+inline YieldAwaiter yield() noexcept {
+  return {};
+}
+
+template <typename T>
+struct FutureAwaiter {
+  std::future<T> future;
+
+  [[nodiscard]] bool is_ready() const { return future.wait_for(std::chrono::seconds{0}) == std::future_status::ready; }
+
+  [[nodiscard]] bool await_ready() const { return is_ready(); }
+  void await_suspend(std::coroutine_handle<> handle) {
+    EventLoop::current()->schedule_when([this] { return is_ready(); }, handle);
+  }
+  T await_resume() { return future.get(); }
+};
+
+/**
+ * @brief Suspend the calling coroutine until `future` has a value, and
+ * return it (or rethrow its exception).
+ */
+template <typename T>
+FutureAwaiter<T> wait(std::future<T> future) {
+  return {std::move(future)};
+}
+
+/**
+ * @brief Await `task`, then call `done` with the exception it threw, if any.
+ */
+template <typename F>
+Task on_completion(Task task, F done) {
+  std::exception_ptr error;
+  try {
+    co_await task;
+  } catch (...) {
+    error = std::current_exception();
+  }
+  done(error);
+}
+
+}  // namespace CppSpec
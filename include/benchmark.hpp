@@ -0,0 +1,178 @@
+/**
+ * @file
+ * @brief Measuring microbenchmarks declared with `benchmark`
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace CppSpec {
+
+/**
+ * @brief How a benchmark is measured.
+ *
+ * The body is first run for at least `warmup`, while working out how many
+ * iterations take about `sample_time`. It's then timed for `samples`
+ * batches of that many iterations.
+ */
+struct BenchmarkOptions {
+  std::chrono::duration<double> warmup{0.01};
+  std::size_t samples = 10;
+  std::chrono::duration<double> sample_time{0.01};
+};
+
+/**
+ * @brief The time one iteration of a benchmark took, in nanoseconds, over
+ * every sample.
+ */
+struct BenchmarkStats {
+  std::uint64_t samples = 0;
+  std::uint64_t iterations = 0;  // Per sample
+  double mean = 0;
+  double median = 0;
+  double stddev = 0;
+  double min = 0;
+
+  static BenchmarkStats of(std::vector<double> per_iteration, std::uint64_t iterations);
+  [[nodiscard]] std::string to_string() const;
+};
+
+/**
+ * @brief Keep the compiler from optimizing away the computation of `value`.
+ */
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#ifdef _MSC_VER
+  const volatile char* sink = &reinterpret_cast<const volatile char&>(value);
+  (void)*sink;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/**
+ * @brief Keep the compiler from optimizing away writes to memory, by
+ * pretending that all of it may be read.
+ */
+inline void clobber() {
+#ifdef _MSC_VER
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : : "memory");
+#endif
+}
+
+inline BenchmarkStats BenchmarkStats::of(std::vector<double> per_iteration, std::uint64_t iterations) {
+  BenchmarkStats stats{.samples = per_iteration.size(), .iterations = iterations};
+  if (per_iteration.empty()) {
+    return stats;
+  }
+  std::ranges::sort(per_iteration);
+  auto count = static_cast<double>(per_iteration.size());
+  std::size_t middle = per_iteration.size() / 2;
+  stats.mean = std::accumulate(per_iteration.begin(), per_iteration.end(), 0.0) / count;
+  stats.median = per_iteration.size() % 2 == 1 ? per_iteration[middle]
+                                               : (per_iteration[middle - 1] + per_iteration[middle]) / 2;
+  stats.min = per_iteration.front();
+  if (per_iteration.size() > 1) {
+    double squares = 0;
+    for (double time : per_iteration) {
+      squares += (time - stats.mean) * (time - stats.mean);
+    }
+    stats.stddev = std::sqrt(squares / (count - 1));
+  }
+  return stats;
+}
+
+/**
+ * @brief Format a time in nanoseconds with a unit that suits it.
+ */
+inline std::string format_nanoseconds(double ns) {
+  if (ns < 1e3) {
+    return std::format("{:.2f} ns", ns);
+  }
+  if (ns < 1e6) {
+    return std::format("{:.2f} us", ns / 1e3);
+  }
+  if (ns < 1e9) {
+    return std::format("{:.2f} ms", ns / 1e6);
+  }
+  return std::format("{:.2f} s", ns / 1e9);
+}
+
+inline std::string BenchmarkStats::to_string() const {
+  return std::format("mean {}, median {}, stddev {}, min {} ({} samples of {} iterations)", format_nanoseconds(mean),
+                     format_nanoseconds(median), format_nanoseconds(stddev), format_nanoseconds(min), samples,
+                     iterations);
+}
+
+/**
+ * @brief Warm up and calibrate a benchmark, then time it.
+ *
+ * The number of iterations is doubled until a batch takes at least a tenth
+ * of `sample_time` (and `warmup` has passed), then scaled up to a whole
+ * sample, so that the clock's resolution doesn't matter even for bodies
+ * that take nanoseconds.
+ *
+ * `stopped` is checked after every batch of iterations; once it returns
+ * true, nothing more is run.
+ *
+ * @return the statistics of the samples, or nothing if it was stopped
+ */
+template <typename F, typename Stopped>
+std::optional<BenchmarkStats> measure(F& body, const BenchmarkOptions& options, Stopped stopped) {
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+  auto time = [&body](std::uint64_t iterations) {
+    auto start = Clock::now();
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+      body();
+    }
+    return Seconds{Clock::now() - start};
+  };
+
+  std::uint64_t iterations = 1;
+  Seconds warmed{};
+  while (true) {
+    Seconds elapsed = time(iterations);
+    if (stopped()) {
+      return std::nullopt;
+    }
+    warmed += elapsed;
+    if (elapsed >= options.sample_time / 10) {
+      if (warmed >= options.warmup) {
+        auto scaled = static_cast<double>(iterations) * (options.sample_time / elapsed);
+        iterations = std::max(iterations, static_cast<std::uint64_t>(std::ceil(scaled)));
+        break;
+      }
+    } else {
+      iterations *= 2;
+    }
+  }
+
+  std::vector<double> per_iteration;
+  per_iteration.reserve(options.samples);
+  for (std::size_t i = 0; i < options.samples; ++i) {
+    per_iteration.push_back(std::chrono::duration<double, std::nano>{time(iterations)}.count() /
+                            static_cast<double>(iterations));
+    if (stopped()) {
+      return std::nullopt;
+    }
+  }
+  return BenchmarkStats::of(std::move(per_iteration), iterations);
+}
+
+}  // namespace CppSpec
@@ -34,7 +34,7 @@ class ClassDescription : public Description {
   ClassDescription(Block block, std::source_location location = std::source_location::current())
       : Description(location, Pretty::to_word(subject)),
         block(block),
-        type(" : " + Util::demangle(typeid(T).name())),
+        type(" : " + Util::demangle(typeid(T))),
         subject(T()) {}
 
   ClassDescription(const char* description,
@@ -52,7 +52,7 @@ class ClassDescription : public Description {
   ClassDescription(U& subject, Block block, std::source_location location = std::source_location::current())
       : Description(location, Pretty::to_word(subject)),
         block(block),
-        type(" : " + Util::demangle(typeid(T).name())),
+        type(" : " + Util::demangle(typeid(T))),
         subject(subject) {}
 
   ClassDescription(const char* description,
@@ -65,7 +65,7 @@ class ClassDescription : public Description {
   ClassDescription(U&& subject, Block block, std::source_location location = std::source_location::current())
       : Description(location, Pretty::to_word(subject)),
         block(block),
-        type(" : " + Util::demangle(typeid(T).name())),
+        type(" : " + Util::demangle(typeid(T))),
         subject(std::forward<U>(subject)) {}
 
   template <typename U>
@@ -74,7 +74,7 @@ class ClassDescription : public Description {
                    std::source_location location = std::source_location::current())
       : Description(location, Pretty::to_word(subject)),
         block(block),
-        type(" : " + Util::demangle(typeid(T).name())),
+        type(" : " + Util::demangle(typeid(T))),
         subject(T(init_list)) {}
 
   template <typename U>
@@ -89,6 +89,19 @@ class ClassDescription : public Description {
               std::source_location location = std::source_location::current());
   ItCD<T>& it(std::function<void(ItCD<T>&)> block, std::source_location location = std::source_location::current());
 
+  template <async_block<ItCD<T>> F>
+  ItCD<T>& it(const char* name, F block, std::source_location location = std::source_location::current());
+  template <async_block<ItCD<T>> F>
+  ItCD<T>& it(F block, std::source_location location = std::source_location::current());
+
+  ItCD<T>& benchmark(const char* name,
+                     std::function<void(ItCD<T>&)> block,
+                     std::source_location location = std::source_location::current());
+  ItCD<T>& benchmark(const char* name,
+                     const BenchmarkOptions& options,
+                     std::function<void(ItCD<T>&)> block,
+                     std::source_location location = std::source_location::current());
+
   template <class U = std::nullptr_t, class B>
   ClassDescription<T>& context(const char* description,
                                B block,
@@ -115,9 +128,13 @@ class ClassDescription : public Description {
   ClassDescription<U>& context(U&& subject, B block, std::source_location location = std::source_location::current()) {
     return this->context("", std::forward<U>(subject), block, location);
   }
-  void run() override;
-
   [[nodiscard]] std::string get_subject_type() const noexcept override { return type; }
+
+  // Swap in the body declared when the enclosing body is run again (see Description::run)
+  void rebind(Block block) noexcept { this->block = std::move(block); }
+
+ protected:
+  void run_block() override { this->block(*this); }
 };
 
 template <Util::not_c_string U>
@@ -135,11 +152,13 @@ ClassContext<U>& ClassDescription<T>::context(const char* description,
                                               U& subject,
                                               B block,
                                               std::source_location location) {
+  auto rebind = [&](ClassContext<U>& redeclared) { redeclared.rebind(block); };
+  if (auto* context = this->template redeclare<ClassContext<U>>(rebind)) {
+    return *context;
+  }
   auto* context = this->make_child<ClassContext<U>>(description, subject, block, location);
-  context->ClassContext<U>::before_eaches = this->before_eaches;
-  context->ClassContext<U>::after_eaches = this->after_eaches;
-  context->timed_run();
-  return *context;
+  context->discover();
+  return this->declare(*context);
 }
 
 template <class T>
@@ -148,68 +167,82 @@ ClassContext<U>& ClassDescription<T>::context(const char* description,
                                               U&& subject,
                                               B block,
                                               std::source_location location) {
+  auto rebind = [&](ClassContext<U>& redeclared) { redeclared.rebind(block); };
+  if (auto* context = this->template redeclare<ClassContext<U>>(rebind)) {
+    return *context;
+  }
   auto* context = this->make_child<ClassContext<U>>(description, std::forward<U>(subject), block, location);
-  context->ClassContext<U>::before_eaches = this->before_eaches;
-  context->ClassContext<U>::after_eaches = this->after_eaches;
-  context->timed_run();
-  return *context;
+  context->discover();
+  return this->declare(*context);
 }
 
 template <class T>
 template <class U, class B>
 ClassContext<T>& ClassDescription<T>::context(const char* description, B block, std::source_location location) {
+  auto rebind = [&](ClassContext<T>& redeclared) { redeclared.rebind(block); };
+  if (auto* context = this->template redeclare<ClassContext<T>>(rebind)) {
+    return *context;
+  }
   auto* context = this->make_child<ClassContext<T>>(description, this->subject, block, location);
-  context->before_eaches = this->before_eaches;
-  context->after_eaches = this->after_eaches;
-  context->timed_run();
-  return *context;
+  context->discover();
+  return this->declare(*context);
 }
 
 template <Util::not_c_string T, class B>
 ClassContext<T>& Description::context(T& subject, B block, std::source_location location) {
+  auto rebind = [&](ClassContext<T>& redeclared) { redeclared.rebind(block); };
+  if (auto* context = redeclare<ClassContext<T>>(rebind)) {
+    return *context;
+  }
   auto* context = this->make_child<ClassContext<T>>(subject, block, location);
-  context->before_eaches = this->before_eaches;
-  context->after_eaches = this->after_eaches;
-  context->timed_run();
-  return *context;
+  context->discover();
+  return declare(*context);
 }
 
 template <class T, class B>
 ClassContext<T>& Description::context(const char* description, T& subject, B block, std::source_location location) {
+  auto rebind = [&](ClassContext<T>& redeclared) { redeclared.rebind(block); };
+  if (auto* context = redeclare<ClassContext<T>>(rebind)) {
+    return *context;
+  }
   auto* context = this->make_child<ClassContext<T>>(description, subject, block, location);
-  context->before_eaches = this->before_eaches;
-  context->after_eaches = this->after_eaches;
-  context->timed_run();
-  return *context;
+  context->discover();
+  return declare(*context);
 }
 
 template <Util::not_c_string T, class B>
 ClassContext<T>& Description::context(T&& subject, B block, std::source_location location) {
+  auto rebind = [&](ClassContext<T>& redeclared) { redeclared.rebind(block); };
+  if (auto* context = redeclare<ClassContext<T>>(rebind)) {
+    return *context;
+  }
   auto* context = this->make_child<ClassContext<T>>(std::forward<T>(subject), block, location);
-  context->before_eaches = this->before_eaches;
-  context->after_eaches = this->after_eaches;
-  context->timed_run();
-  return *context;
+  context->discover();
+  return declare(*context);
 }
 
 template <class T, class B>
 ClassContext<T>& Description::context(const char* description, T&& subject, B block, std::source_location location) {
+  auto rebind = [&](ClassContext<T>& redeclared) { redeclared.rebind(block); };
+  if (auto* context = redeclare<ClassContext<T>>(rebind)) {
+    return *context;
+  }
   auto* context = this->make_child<ClassContext<T>>(description, std::forward<T>(subject), block, location);
-  context->before_eaches = this->before_eaches;
-  context->after_eaches = this->after_eaches;
-  context->timed_run();
-  return *context;
+  context->discover();
+  return declare(*context);
 }
 
 template <class T, typename U>
 ClassContext<T>& Description::context(std::initializer_list<U> init_list,
                                       std::function<void(ClassDescription<T>&)> block,
                                       std::source_location location) {
+  auto rebind = [&](ClassContext<T>& redeclared) { redeclared.rebind(block); };
+  if (auto* context = redeclare<ClassContext<T>>(rebind)) {
+    return *context;
+  }
   auto* context = this->make_child<ClassContext<T>>(T(init_list), block, location);
-  context->before_eaches = this->before_eaches;
-  context->after_eaches = this->after_eaches;
-  context->timed_run();
-  return *context;
+  context->discover();
+  return declare(*context);
 }
 
 /**
@@ -235,11 +268,10 @@ ClassContext<T>& Description::context(std::initializer_list<U> init_list,
  */
 template <class T>
 ItCD<T>& ClassDescription<T>::it(const char* name, std::function<void(ItCD<T>&)> block, std::source_location location) {
-  exec_before_eaches();
-  auto* it = this->make_child<ItCD<T>>(location, this->subject, name, block);
-  it->timed_run();
-  exec_after_eaches();
-  return *it;
+  if (auto* example = this->template redeclare<ItCD<T>>([&](ItCD<T>& it) { it.rebind(std::move(block)); })) {
+    return *example;
+  }
+  return this->declare(*this->make_child<ItCD<T>>(location, this->subject, name, block));
 }
 
 /**
@@ -265,26 +297,80 @@ ItCD<T>& ClassDescription<T>::it(const char* name, std::function<void(ItCD<T>&)>
  */
 template <class T>
 ItCD<T>& ClassDescription<T>::it(std::function<void(ItCD<T>&)> block, std::source_location location) {
-  exec_before_eaches();
-  auto* it = this->make_child<ItCD<T>>(location, this->subject, block);
-  it->timed_run();
-  exec_after_eaches();
-  return *it;
+  if (auto* example = this->template redeclare<ItCD<T>>([&](ItCD<T>& it) { it.rebind(std::move(block)); })) {
+    return *example;
+  }
+  return this->declare(*this->make_child<ItCD<T>>(location, this->subject, block));
+}
+
+/**
+ * An `it` whose body is a coroutine; see Description::it.
+ */
+template <class T>
+template <async_block<ItCD<T>> F>
+ItCD<T>& ClassDescription<T>::it(const char* name, F block, std::source_location location) {
+  using AsyncBlock = typename ItCD<T>::AsyncBlock;
+  auto rebind = [&](ItCD<T>& it) { it.rebind(AsyncBlock{std::move(block)}); };
+  if (auto* example = this->template redeclare<ItCD<T>>(rebind)) {
+    return *example;
+  }
+  return this->declare(*this->make_child<ItCD<T>>(location, this->subject, name, AsyncBlock{std::move(block)}));
 }
 
 template <class T>
-void ClassDescription<T>::run() {
-  this->block(*this);
-  for (const auto& a : after_alls) {
-    a();
+template <async_block<ItCD<T>> F>
+ItCD<T>& ClassDescription<T>::it(F block, std::source_location location) {
+  using AsyncBlock = typename ItCD<T>::AsyncBlock;
+  auto rebind = [&](ItCD<T>& it) { it.rebind(AsyncBlock{std::move(block)}); };
+  if (auto* example = this->template redeclare<ItCD<T>>(rebind)) {
+    return *example;
   }
+  return this->declare(*this->make_child<ItCD<T>>(location, this->subject, AsyncBlock{std::move(block)}));
+}
+
+/**
+ * A benchmark of the subject; see Description::benchmark.
+ */
+template <class T>
+ItCD<T>& ClassDescription<T>::benchmark(const char* name,
+                                        std::function<void(ItCD<T>&)> block,
+                                        std::source_location location) {
+  return benchmark(name, BenchmarkOptions{}, std::move(block), location);
+}
+
+template <class T>
+ItCD<T>& ClassDescription<T>::benchmark(const char* name,
+                                        const BenchmarkOptions& options,
+                                        std::function<void(ItCD<T>&)> block,
+                                        std::source_location location) {
+  if (auto* example = this->template redeclare<ItCD<T>>([&](ItCD<T>& it) { it.rebind(std::move(block)); })) {
+    return *example;
+  }
+  auto& example = this->declare(*this->make_child<ItCD<T>>(location, this->subject, name, std::move(block)));
+  example.set_benchmark(options);
+  return example;
 }
 
 template <class T>
 void ItCD<T>::run() {
-  this->block(*this);
-  auto* cd = this->get_parent_as<ClassDescription<T>>();
-  cd->reset_lets();
+  LetFrame lets;  // This example's own let values
+  LetFrame::Scope scope{lets};
+  auto* parent = this->get_parent_as<Description>();
+  parent->exec_before_eaches();
+  if (this->is_benchmark()) {
+    this->run_benchmark([this] { this->block(*this); });
+  } else {
+    this->block(*this);
+  }
+  parent->exec_after_eaches();
+}
+
+template <class T>
+Task ItCD<T>::run_async() {
+  auto* parent = this->get_parent_as<Description>();
+  parent->exec_before_eaches();
+  co_await this->async_block(*this);
+  parent->exec_after_eaches();
 }
 
 }  // namespace CppSpec
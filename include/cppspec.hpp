@@ -15,9 +15,13 @@
 // GCC and clang have no problem with it being omitted. Weird.
 #define $ [](auto& self) -> void
 #define _ [=](auto& self) mutable -> void
+// The body of an asynchronous `it`, which can co_await
+#define _async [=](auto& self) mutable -> CppSpec::Task
 
 #define it self.it
 #define specify it
+// Prefixed, so that names such as Google Benchmark's `benchmark` namespace are left alone
+#define it_benchmark self.benchmark
 
 // Apparently MSVC++ doesn't conform to C++14 14.2/4. Annoying.
 #define context self.context
@@ -38,6 +42,7 @@
   int main(int argc, char** const argv) {                                                                    \
     return CppSpec::parse(argc, argv).add_specs(__VA_ARGS__).exec().is_success() ? EXIT_SUCCESS : EXIT_FAILURE; \
   }                                                                                                          \
+  CPPSPEC_ALLOCATION_FUNCTIONS                                                                               \
   extern "C" int _getentropy(void* buf, size_t buflen) {                                                     \
     return -1;                                                                                               \
   }
@@ -46,7 +51,8 @@
 #define CPPSPEC_MAIN(...)                                                                                    \
   int main(int argc, char** const argv) {                                                                    \
     return CppSpec::parse(argc, argv).add_specs(__VA_ARGS__).exec().is_success() ? EXIT_SUCCESS : EXIT_FAILURE; \
-  }
+  }                                                                                                          \
+  CPPSPEC_ALLOCATION_FUNCTIONS
 #endif
 
 #define CPPSPEC_SPEC(spec_name)                                                                              \
@@ -4,21 +4,82 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <deque>
+#include <exception>
+#include <format>
 #include <forward_list>
+#include <functional>
 #include <list>
 #include <memory>
+#include <optional>
 #include <source_location>
 #include <string>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include "it.hpp"
 
+#ifndef CPPSPEC_SEMIHOSTED
+#include "scheduler.hpp"
+#endif
+
 namespace CppSpec {
 
 template <class T>
 class ClassDescription;  // forward-declaration for ClassDescription
 
+/**
+ * @brief State shared by every Description running under one Runner, used
+ * to stop a run early and to keep an eye on slow examples.
+ *
+ * Once `max_failures` examples have failed (or errored), no further
+ * examples are started. Those already running are allowed to finish.
+ */
+class RunControl {
+  std::size_t max_failures_;  // 0 never stops the run
+  std::atomic<std::size_t> failures_ = 0;
+  std::atomic<bool> stopped_ = false;
+
+ public:
+  using Seconds = std::chrono::duration<double>;
+
+  // The timeout of examples that (and whose Descriptions) don't set their own
+  std::optional<Seconds> default_timeout;
+
+  // Fail examples that don't free what they allocate, rather than only flagging them (see allocations.hpp)
+  bool fail_on_leaks = false;
+
+  // Called around every example that has a timeout, e.g. to watch for it hanging
+  std::function<void(ItBase&, Seconds)> on_timed_start;
+  std::function<void(ItBase&)> on_timed_finish;
+
+  // Called once any example has finished and all of its results are in
+  std::function<void(ItBase&)> on_finished;
+
+  explicit RunControl(std::size_t max_failures = 0) noexcept : max_failures_(max_failures) {}
+
+  void record_failures(std::size_t count) noexcept {
+    if (count == 0) {
+      return;
+    }
+    std::size_t total = failures_.fetch_add(count, std::memory_order_relaxed) + count;
+    if (max_failures_ != 0 && total >= max_failures_) {
+      stopped_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // Don't start any more examples, however many have failed
+  void stop() noexcept { stopped_.store(true, std::memory_order_relaxed); }
+
+  [[nodiscard]] std::size_t failures() const noexcept { return failures_.load(std::memory_order_relaxed); }
+  [[nodiscard]] bool stopped() const noexcept { return stopped_.load(std::memory_order_relaxed); }
+};
+
 class Description : public Runnable {
   using VoidBlock = std::function<void()>;
 
@@ -26,19 +87,47 @@ class Description : public Runnable {
   using Block = std::function<void(Description&)>;
 
   std::forward_list<LetBase*> lets;
+  std::deque<VoidBlock> before_alls;
   std::deque<VoidBlock> after_alls;
   std::deque<VoidBlock> before_eaches;
   std::deque<VoidBlock> after_eaches;
 
  private:
+  // Something the body of the `describe` declared, in the order it did
+  struct Declaration {
+    const void* kind;  // The typeid of an example, context or let, or the hooks a hook is one of
+    void* declared;
+  };
+  // Thrown out of a body that declares something else when it is run again
+  struct Diverged {};
+
   Block block;
   std::list<std::unique_ptr<LetBase>> owned_lets_;
+  std::vector<Declaration> declarations_;
+  std::optional<std::size_t> redeclaring_;  // The next declaration, while the body is run again
+  bool children_ran_ = false;
+  bool discovered_ = false;
+  bool serial_ = false;
+  std::optional<RunControl::Seconds> timeout_;
+  RunControl* run_control_ = nullptr;
+
+  void rerun_block(RunControl* control);
+  void run_children(RunControl* control);
+  void run_child(Runnable& child, RunControl* control);
+  void run_async_examples(const std::vector<ItBase*>& examples, RunControl* control);
+  void finish_example(ItBase& it, std::optional<RunControl::Seconds> timeout, RunControl* control);
+  void fail_unrun(const std::string& message, RunControl* control);
 
  protected:
   std::string description;
 
-  void exec_before_eaches();
-  void exec_after_eaches();
+  // Run the body of the `describe`, which declares (but does not run) its children
+  virtual void run_block() { block(*this); }
+
+  template <typename T>
+  T& declare(T& declared, const void* kind = &typeid(T));
+  template <typename T, typename Rebind>
+  T* redeclare(Rebind rebind, const void* kind = &typeid(T));
 
  public:
   // Primary constructor. Entry of all specs.
@@ -55,11 +144,27 @@ class Description : public Runnable {
   Description(std::source_location location, const char* description, Block block) noexcept
       : Runnable(location), block(std::move(block)), description(description) {}
 
+  // Swap in the body declared when the enclosing body is run again (see Description::run)
+  void rebind(Block block) noexcept { this->block = std::move(block); }
+
   /********* Specify/It *********/
 
   ItD& it(const char* name, ItD::Block body, std::source_location location = std::source_location::current());
   ItD& it(ItD::Block body, std::source_location location = std::source_location::current());
 
+  template <async_block<ItD> F>
+  ItD& it(const char* name, F body, std::source_location location = std::source_location::current());
+  template <async_block<ItD> F>
+  ItD& it(F body, std::source_location location = std::source_location::current());
+
+  /********* Benchmark *********/
+
+  ItD& benchmark(const char* name, ItD::Block body, std::source_location location = std::source_location::current());
+  ItD& benchmark(const char* name,
+                 const BenchmarkOptions& options,
+                 ItD::Block body,
+                 std::source_location location = std::source_location::current());
+
   /********* Context ***********/
 
   template <class T = std::nullptr_t>
@@ -97,6 +202,10 @@ class Description : public Runnable {
   void after_each(VoidBlock block);
   void after_all(VoidBlock block);
 
+  // Run the hook chains surrounding a single example, including those of every ancestor
+  void exec_before_eaches();
+  void exec_after_eaches();
+
   /********* Let *********/
 
   template <typename F>
@@ -110,6 +219,31 @@ class Description : public Runnable {
 
   /********* Run *********/
 
+  void discover();
+  [[nodiscard]] bool discovered() const noexcept { return discovered_; }
+
+  using Predicate = std::function<bool(const ItBase&)>;
+  bool select_examples(const Predicate& predicate);
+
+  // Opt out of running this Description's examples in parallel with each other
+  Description& serial() noexcept {
+    serial_ = true;
+    return *this;
+  }
+  [[nodiscard]] bool is_serial() const noexcept;
+
+  // Give every example in this Description (unless overridden) a time limit
+  Description& timeout(RunControl::Seconds timeout) noexcept {
+    timeout_ = timeout;
+    return *this;
+  }
+  [[nodiscard]] std::optional<RunControl::Seconds> get_timeout() const noexcept;
+  [[nodiscard]] std::optional<RunControl::Seconds> timeout_for(const ItBase& it) const noexcept;
+
+  // Set by the Runner on the outermost Description, and shared by everything inside it
+  void set_run_control(RunControl* control) noexcept { run_control_ = control; }
+  [[nodiscard]] RunControl* get_run_control() const noexcept;
+
   void run() override;
   // std::function<int(int, char **)>
   template <typename Formatter>
@@ -123,62 +257,137 @@ using Context = Description;
 /*========= Description::it =========*/
 
 inline ItD& Description::it(const char* description, ItD::Block block, std::source_location location) {
-  exec_before_eaches();
-  auto* it = this->make_child<ItD>(location, description, block);
-  it->timed_run();
-  exec_after_eaches();
-  return *it;
+  if (auto* example = redeclare<ItD>([&](ItD& it) { it.rebind(std::move(block)); })) {
+    return *example;
+  }
+  return declare(*this->make_child<ItD>(location, description, block));
 }
 
 inline ItD& Description::it(ItD::Block block, std::source_location location) {
-  exec_before_eaches();
-  auto* it = this->make_child<ItD>(location, block);
-  it->timed_run();
-  exec_after_eaches();
-  return *it;
+  if (auto* example = redeclare<ItD>([&](ItD& it) { it.rebind(std::move(block)); })) {
+    return *example;
+  }
+  return declare(*this->make_child<ItD>(location, block));
+}
+
+/**
+ * An `it` whose body is a coroutine. Asynchronous examples in the same
+ * Description run concurrently, on one EventLoop.
+ *
+ * @code
+ *   it("responds", _async {
+ *     co_await CppSpec::sleep_for(10ms);
+ *     expect(server.responded()).to_be_true();
+ *   });
+ * @endcode
+ */
+template <async_block<ItD> F>
+ItD& Description::it(const char* description, F block, std::source_location location) {
+  if (auto* example = redeclare<ItD>([&](ItD& it) { it.rebind(ItD::AsyncBlock{std::move(block)}); })) {
+    return *example;
+  }
+  return declare(*this->make_child<ItD>(location, description, ItD::AsyncBlock{std::move(block)}));
+}
+
+template <async_block<ItD> F>
+ItD& Description::it(F block, std::source_location location) {
+  if (auto* example = redeclare<ItD>([&](ItD& it) { it.rebind(ItD::AsyncBlock{std::move(block)}); })) {
+    return *example;
+  }
+  return declare(*this->make_child<ItD>(location, ItD::AsyncBlock{std::move(block)}));
+}
+
+/*========= Description::benchmark =========*/
+
+/**
+ * An example that is timed once it has passed, reporting the mean, median,
+ * standard deviation and minimum time of an iteration of its body. Its
+ * before_each and after_each hooks run once, around all of the iterations.
+ *
+ * @code
+ *   it_benchmark("sorting 1000 ints", _ {
+ *     std::vector<int> v = shuffled(1000);
+ *     std::ranges::sort(v);
+ *     CppSpec::do_not_optimize(v);
+ *   });
+ * @endcode
+ */
+inline ItD& Description::benchmark(const char* name, ItD::Block body, std::source_location location) {
+  return benchmark(name, BenchmarkOptions{}, std::move(body), location);
+}
+
+inline ItD& Description::benchmark(const char* name,
+                                   const BenchmarkOptions& options,
+                                   ItD::Block body,
+                                   std::source_location location) {
+  if (auto* example = redeclare<ItD>([&](ItD& it) { it.rebind(std::move(body)); })) {
+    return *example;
+  }
+  auto& example = declare(*this->make_child<ItD>(location, name, std::move(body)));
+  example.set_benchmark(options);
+  return example;
 }
 
 /*========= Description::context =========*/
 
 template <class T>
 inline Context& Description::context(const char* description, Block body, std::source_location location) {
+  if (auto* context = redeclare<Context>([&](Context& redeclared) { redeclared.rebind(std::move(body)); })) {
+    return *context;
+  }
   auto* context = this->make_child<Context>(location, description, body);
-  context->before_eaches = this->before_eaches;
-  context->after_eaches = this->after_eaches;
-  context->timed_run();
-  return *context;
+  context->discover();
+  return declare(*context);
 }
 
 /*========= Description:: each/alls =========*/
 
 inline void Description::before_each(VoidBlock b) {
-  before_eaches.push_back(std::move(b));
+  if (redeclare<VoidBlock>([&](VoidBlock& hook) { hook = std::move(b); }, &before_eaches) == nullptr) {
+    declare(before_eaches.emplace_back(std::move(b)), &before_eaches);
+  }
 }
 
 inline void Description::before_all(VoidBlock b) {
-  b();
+  if (redeclare<VoidBlock>([&](VoidBlock& hook) { hook = std::move(b); }, &before_alls) == nullptr) {
+    declare(before_alls.emplace_back(std::move(b)), &before_alls);
+  }
 }
 
 inline void Description::after_each(VoidBlock b) {
-  after_eaches.push_back(b);
+  if (redeclare<VoidBlock>([&](VoidBlock& hook) { hook = std::move(b); }, &after_eaches) == nullptr) {
+    declare(after_eaches.emplace_back(std::move(b)), &after_eaches);
+  }
 }
 
 inline void Description::after_all(VoidBlock b) {
-  after_alls.push_back(b);
+  if (redeclare<VoidBlock>([&](VoidBlock& hook) { hook = std::move(b); }, &after_alls) == nullptr) {
+    declare(after_alls.emplace_back(std::move(b)), &after_alls);
+  }
 }
 
-/*----------- private -------------*/
-
+/**
+ * @brief Run the before_each hooks for an example, outermost first.
+ */
 inline void Description::exec_before_eaches() {
+  if (this->has_parent()) {
+    this->get_parent_as<Description>()->exec_before_eaches();
+  }
   for (VoidBlock& b : before_eaches) {
     b();
   }
 }
 
+/**
+ * @brief Run the after_each hooks for an example, innermost first.
+ */
 inline void Description::exec_after_eaches() {
   for (VoidBlock& b : after_eaches) {
     b();
   }
+  if (this->has_parent()) {
+    this->get_parent_as<Description>()->exec_after_eaches();
+  }
 }
 
 /*========= Description::let =========*/
@@ -186,11 +395,14 @@ inline void Description::exec_after_eaches() {
 template <typename F>
 auto& Description::let(F factory) {
   using T = decltype(std::declval<F>()());
+  if (auto* let = redeclare<Let<T>>([&](Let<T>& redeclared) { redeclared.rebind(std::move(factory)); })) {
+    return *let;
+  }
   auto ptr = std::make_unique<Let<T>>(std::move(factory));
   auto* raw = ptr.get();
   owned_lets_.push_back(std::move(ptr));
   lets.push_front(raw);
-  return *raw;
+  return declare(*raw);
 }
 
 inline void Description::reset_lets() noexcept {
@@ -205,22 +417,442 @@ inline void Description::reset_lets() noexcept {
   }
 }
 
+/*========= Description::discover =========*/
+
+/**
+ * @brief Build the tree of examples beneath this Description.
+ *
+ * Runs the body of the `describe`, which registers hooks and lets and
+ * declares every `it` and `context` it contains. Nested contexts are
+ * discovered as they are declared. No example bodies or hooks are run.
+ * Discovery only ever happens once.
+ */
+inline void Description::discover() {
+  if (discovered_) {
+    return;
+  }
+  discovered_ = true;
+  run_block();
+}
+
+/**
+ * @brief Record something the body declared during discovery, so that it
+ * can be found again when the body is run again.
+ */
+template <typename T>
+T& Description::declare(T& declared, const void* kind) {
+  declarations_.push_back({kind, &declared});
+  return declared;
+}
+
+/**
+ * @brief While the body is being run again, hand what was declared in the
+ * place of this declaration during discovery to `rebind`, and run the
+ * children once the last declaration has been made.
+ *
+ * @return what was declared during discovery, or nullptr outside of a rerun
+ * @throws Diverged if something else was declared in this place
+ */
+template <typename T, typename Rebind>
+T* Description::redeclare(Rebind rebind, const void* kind) {
+  if (!redeclaring_) {
+    return nullptr;
+  }
+  if (*redeclaring_ == declarations_.size() || declarations_[*redeclaring_].kind != kind) {
+    throw Diverged{};
+  }
+  auto* declared = static_cast<T*>(declarations_[(*redeclaring_)++].declared);
+  rebind(*declared);
+  if (*redeclaring_ == declarations_.size()) {
+    run_children(get_run_control());
+  }
+  return declared;
+}
+
+/*========= Description::select_examples =========*/
+
+/**
+ * @brief Narrow down which of the examples beneath this Description are run.
+ *
+ * Every example that is still selected stays selected only if it satisfies
+ * `predicate`. Descriptions that are left without any selected examples are
+ * deselected as well, so their hooks are never run and formatters skip them.
+ *
+ * @return whether any example beneath this Description is still selected
+ */
+inline bool Description::select_examples(const Predicate& predicate) {
+  bool any_selected = false;
+  for (auto& child : get_children()) {
+    if (auto* description = dynamic_cast<Description*>(child)) {
+      any_selected |= description->select_examples(predicate);
+    } else if (auto* it = dynamic_cast<ItBase*>(child)) {
+      it->set_selected(it->is_selected() && predicate(*it));
+      any_selected |= it->is_selected();
+    }
+  }
+  this->set_selected(any_selected);
+  return any_selected;
+}
+
 /*========= Description::run =========*/
 
+/**
+ * @brief Whether this Description, or any that contains it, opted out of
+ * parallel execution.
+ */
+inline bool Description::is_serial() const noexcept {
+  if (serial_) {
+    return true;
+  }
+  return this->has_parent() && this->get_parent_as<Description>()->is_serial();
+}
+
+inline RunControl* Description::get_run_control() const noexcept {
+  if (run_control_ != nullptr || !this->has_parent()) {
+    return run_control_;
+  }
+  return this->get_parent_as<Description>()->get_run_control();
+}
+
+/**
+ * @brief The timeout set on this Description, or on the closest one containing it.
+ */
+inline std::optional<RunControl::Seconds> Description::get_timeout() const noexcept {
+  if (timeout_ || !this->has_parent()) {
+    return timeout_;
+  }
+  return this->get_parent_as<Description>()->get_timeout();
+}
+
+/**
+ * @brief The timeout of one of this Description's examples: its own, else
+ * that of its Descriptions, else the default of the run.
+ */
+inline std::optional<RunControl::Seconds> Description::timeout_for(const ItBase& it) const noexcept {
+  if (auto timeout = it.get_timeout()) {
+    return timeout;
+  }
+  if (auto timeout = get_timeout()) {
+    return timeout;
+  }
+  RunControl* control = get_run_control();
+  return control != nullptr ? control->default_timeout : std::nullopt;
+}
+
+/**
+ * @brief Run a single child, unless the run has been stopped.
+ *
+ * A child that isn't started is deselected, so that it isn't reported. An
+ * example that takes longer than its timeout gets an error result.
+ */
+inline void Description::run_child(Runnable& child, RunControl* control) {
+  if (control != nullptr && control->stopped()) {
+    child.set_selected(false);
+    return;
+  }
+
+  auto* it = dynamic_cast<ItBase*>(&child);
+  if (it == nullptr) {
+    child.timed_run();
+    return;
+  }
+
+  std::optional<RunControl::Seconds> timeout = timeout_for(*it);
+  if (timeout && control != nullptr && control->on_timed_start) {
+    control->on_timed_start(*it, *timeout);
+  }
+  it->timed_run();
+  finish_example(*it, timeout, control);
+}
+
+/**
+ * @brief Account for an example that has finished running: check it against
+ * its timeout (and for leaks, if the run fails on them), and count it
+ * towards the run's failures.
+ */
+inline void Description::finish_example(ItBase& it, std::optional<RunControl::Seconds> timeout, RunControl* control) {
+  if (timeout) {
+    if (control != nullptr && control->on_timed_finish) {
+      control->on_timed_finish(it);
+    }
+    if (it.get_runtime() > *timeout) {
+      it.add_result(Result::error_with(it.get_location(), std::format("Timed out after {}s", timeout->count())));
+    }
+  }
+
+  const auto& allocations = it.get_allocations();
+  if (allocations && allocations->leaked() && control != nullptr && control->fail_on_leaks) {
+    it.add_result(Result::failure_with(it.get_location(), std::format("Leaked {} bytes in {} allocations",
+                                                                      allocations->live_bytes,
+                                                                      allocations->live_allocations)));
+  }
+
+  if (control != nullptr) {
+    Result result = it.get_result();
+    control->record_failures(result.is_failure() || result.is_error() ? 1 : 0);
+    if (control->on_finished) {
+      control->on_finished(it);
+    }
+  }
+}
+
+/**
+ * @brief Run asynchronous examples concurrently on one EventLoop, so that
+ * examples waiting on timers, futures or sockets overlap.
+ *
+ * Every example is started in order (running its before_eaches up to its
+ * first suspension), and the loop then resumes whichever can make progress
+ * until all of them have finished. Each keeps its own LetFrame, and is timed
+ * from its start to its own completion. Once the RunControl says to stop,
+ * examples that haven't been started are skipped.
+ */
+inline void Description::run_async_examples(const std::vector<ItBase*>& examples, RunControl* control) {
+  using Clock = std::chrono::steady_clock;
+  struct Running {
+    ItBase* it = nullptr;
+    std::optional<RunControl::Seconds> timeout;
+    Clock::time_point started;
+    LetFrame lets;
+    bool finished = false;
+  };
+
+  auto error_message = [](const std::exception_ptr& error) -> std::string {
+    try {
+      std::rethrow_exception(error);
+    } catch (std::exception& e) {
+      return e.what();
+    } catch (...) {
+      return "Unknown exception thrown during example execution.";
+    }
+  };
+
+  std::deque<Running> running;  // A deque, so that the LetFrames never move
+  std::vector<Task> tasks;
+  EventLoop loop;
+  for (ItBase* it : examples) {
+    if (control != nullptr && control->stopped()) {
+      it->set_selected(false);
+      continue;
+    }
+
+    Running& example = running.emplace_back();
+    example.it = it;
+    example.timeout = timeout_for(*it);
+    if (example.timeout && control != nullptr && control->on_timed_start) {
+      control->on_timed_start(*it, *example.timeout);
+    }
+    it->set_start_time(std::chrono::system_clock::now());
+    example.started = Clock::now();
+
+    LetFrame::Scope scope{example.lets};  // Captured by the loop along with the Task
+    tasks.push_back(on_completion(it->run_async(), [&](const std::exception_ptr& error) {
+      example.it->set_runtime(Clock::now() - example.started);
+      if (error) {
+        example.it->add_result(Result::error_with(example.it->get_location(), error_message(error)));
+      }
+      example.finished = true;
+      finish_example(*example.it, example.timeout, control);
+    }));
+    loop.schedule(tasks.back().handle());
+  }
+
+  loop.run();
+
+  // Anything left was suspended on an awaitable that never resumed it
+  for (Running& example : running) {
+    if (!example.finished) {
+      example.it->set_runtime(Clock::now() - example.started);
+      example.it->add_result(
+          Result::error_with(example.it->get_location(), "Never finished: still suspended with nothing left to run"));
+      finish_example(*example.it, example.timeout, control);
+    }
+  }
+}
+
+/**
+ * @brief Mark every example beneath this Description that was to be run as
+ * an error, without running it.
+ */
+inline void Description::fail_unrun(const std::string& message, RunControl* control) {
+  for (auto& child : get_children()) {
+    if (!child->is_selected()) {
+      continue;
+    }
+    if (auto* description = dynamic_cast<Description*>(child)) {
+      description->fail_unrun(message, control);
+    } else if (auto* it = dynamic_cast<ItBase*>(child)) {
+      it->set_start_time(std::chrono::system_clock::now());
+      it->add_result(Result::error_with(it->get_location(), message));
+      finish_example(*it, std::nullopt, control);
+    }
+  }
+}
+
+/**
+ * @brief Run the examples and contexts contained in this Description.
+ *
+ * The body of the `describe` is run again, and the children are run from
+ * inside it once it has made its last declaration, so that its locals are
+ * still alive for hooks, lets and examples that captured them by reference.
+ * Nothing new is declared the second time round: each declaration hands
+ * its fresh block to what it declared during discovery. A body without any
+ * declarations isn't run again.
+ *
+ * Once the RunControl says to stop, children that haven't started yet are
+ * skipped (and deselected), as is this Description if none of its children
+ * got to run.
+ */
 inline void Description::run() {
-  block(*this);  // Run the block
+  discover();  // Make sure the tree has been built
+  RunControl* control = get_run_control();
+  if (control != nullptr && control->stopped()) {
+    this->set_selected(false);
+    return;
+  }
+
+  if (declarations_.empty()) {
+    run_children(control);
+  } else {
+    rerun_block(control);
+  }
+
+  if (control != nullptr && control->stopped() &&
+      std::ranges::none_of(get_children(), [](const auto& child) { return child->is_selected(); })) {
+    this->set_selected(false);
+  }
+}
+
+/**
+ * @brief Run the body of the `describe` again, which runs the children once
+ * it has redeclared everything (see Description::redeclare).
+ *
+ * A body that declares something else, or less, than it did during
+ * discovery can't be matched up with the tree, so its examples are reported
+ * as errors rather than run. Anything it declares after the children have
+ * run is ignored.
+ */
+inline void Description::rerun_block(RunControl* control) {
+  redeclaring_ = 0;
+  children_ran_ = false;
+  try {
+    run_block();
+  } catch (const Diverged&) {
+    // Reported below, unless the children got to run
+  } catch (...) {
+    redeclaring_.reset();
+    throw;
+  }
+  redeclaring_.reset();
+  if (!children_ran_) {
+    fail_unrun("Not run: the describe block declared different examples, contexts, hooks or lets when run again",
+               control);
+  }
+}
+
+/**
+ * @brief Run the before_alls, every child and the after_alls.
+ *
+ * When running on a Scheduler (i.e. with `--jobs`), every child becomes a
+ * task that any worker can pick up, unless this Description is serial.
+ * The before_alls still run before, and the after_alls after, all of them.
+ */
+inline void Description::run_children(RunControl* control) {
+  children_ran_ = true;
+  for (VoidBlock& b : before_alls) {
+    b();
+  }
+
+  // Asynchronous examples are run together, rather than one at a time
+  std::vector<ItBase*> async_examples;
+  for (auto& child : get_children()) {
+    auto* it = dynamic_cast<ItBase*>(child);
+    if (it != nullptr && it->is_selected() && it->is_async()) {
+      async_examples.push_back(it);
+    }
+  }
+  auto is_async = [](const Runnable& child) {
+    const auto* it = dynamic_cast<const ItBase*>(&child);
+    return it != nullptr && it->is_async();
+  };
+
+#ifndef CPPSPEC_SEMIHOSTED
+  Scheduler* scheduler = Scheduler::current();
+  if (scheduler != nullptr && !is_serial() && get_children().size() > 1) {
+    TaskGroup group{*scheduler};
+    if (!async_examples.empty()) {
+      group.spawn([this, &async_examples, control] { run_async_examples(async_examples, control); });
+    }
+    for (auto& child : get_children()) {
+      if (child->is_selected() && !is_async(*child)) {
+        group.spawn([this, child, control] { run_child(*child, control); });
+      }
+    }
+    group.wait();
+  } else
+#endif
+  {
+    bool async_started = false;
+    for (auto& child : get_children()) {
+      if (!child->is_selected()) {
+        continue;
+      }
+      if (!is_async(*child)) {
+        run_child(*child, control);
+      } else if (!async_started) {
+        // Where the first of them was declared
+        async_started = true;
+        run_async_examples(async_examples, control);
+      }
+    }
+  }
+
   for (VoidBlock& a : after_alls) {
     a();  // Run all our after_alls
   }
 }
 
+/*>>>>>>>>>>>>>>>>>>>> ItBase <<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+/*========= ItBase::get_full_description =========*/
+
+inline std::string ItBase::get_full_description() const {
+  // Build up the description for the test by ascending the
+  // execution tree and chaining the individual descriptions together
+  std::forward_list<std::string> descriptions;
+
+  descriptions.push_front(this->get_description());
+  for (const auto* parent = this->get_parent_as<Description>(); parent->has_parent();
+       parent = parent->get_parent_as<Description>()) {
+    descriptions.push_front(parent->get_description());
+  }
+
+  return Util::join(descriptions, " ");
+}
+
 /*>>>>>>>>>>>>>>>>>>>> ItD <<<<<<<<<<<<<<<<<<<<<<<<<*/
 
 /*========= ItD::run =========*/
 
 inline void ItD::run() {
-  block(*this);
-  this->get_parent_as<Description>()->reset_lets();
+  LetFrame lets;  // This example's own let values
+  LetFrame::Scope scope{lets};
+  auto* parent = this->get_parent_as<Description>();
+  parent->exec_before_eaches();
+  if (is_benchmark()) {
+    run_benchmark([this] { block(*this); });
+  } else {
+    block(*this);
+  }
+  parent->exec_after_eaches();
+}
+
+/*========= ItD::run_async =========*/
+
+inline Task ItD::run_async() {
+  auto* parent = this->get_parent_as<Description>();
+  parent->exec_before_eaches();
+  co_await async_block(*this);
+  parent->exec_after_eaches();
 }
 
 }  // namespace CppSpec
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <exception>
 #include <optional>
 #include <regex>
@@ -8,6 +9,7 @@
 #include <vector>
 
 #include "matchers/be_nullptr.hpp"
+#include "matchers/complete_within.hpp"
 #include "matchers/contain.hpp"
 #include "matchers/equal.hpp"
 #include "matchers/errors/fail.hpp"
@@ -78,6 +80,11 @@ class Expectation {
   [[nodiscard]] constexpr bool positive() const { return is_positive_; }
   [[nodiscard]] constexpr bool ignored() const { return ignore_; }
 
+ protected:
+  template <class M>
+  void check(M matcher, std::string msg);
+
+ public:
   /********* Modifiers *********/
 
   virtual Expectation& not_() = 0;
@@ -117,6 +124,8 @@ class Expectation {
   void to_match(std::string str, std::string msg = "");
   void to_partially_match(std::regex regex, std::string msg = "");
   void to_partially_match(std::string str, std::string msg = "");
+  template <Util::fixed_string Source>
+  void to_match(std::string msg = "");
   template <typename F>
     requires std::invocable<F, A> && std::convertible_to<std::invoke_result_t<F, A>, bool>
   void to_satisfy(F test, std::string msg = "");
@@ -163,6 +172,35 @@ void Expectation<A>::to(M matcher, std::string msg) {
   matcher.set_message(std::move(msg)).run();
 }
 
+/**
+ * @brief Run one of the built-in matchers.
+ *
+ * An example without a description is described by its first expectation.
+ * When the expected value is self-contained (and the built-in matchers only
+ * describe themselves from it and their own members), a detached copy of
+ * the matcher, which no longer refers to this Expectation, does that once
+ * the description is actually needed instead.
+ *
+ * @param matcher the matcher to run
+ * @param msg Optional message to give on failure.
+ */
+template <typename A>
+template <class M>
+void Expectation<A>::check(M matcher, std::string msg) {
+  if constexpr (Util::is_self_contained<typename M::expected_t>) {
+    if (it != nullptr && it->needs_description() && !ignored()) {
+      Allocations::Pause pause;  // Kept by the example, not allocated by it
+      M described = matcher;
+      described.detach();  // It outlives this Expectation
+      it->defer_description([positive = positive(), described = std::move(described)]() mutable {
+        return (positive ? PositiveExpectationHandler::verb() : NegativeExpectationHandler::verb()) + " " +
+               described.description();
+      });
+    }
+  }
+  matcher.set_message(std::move(msg)).run();
+}
+
 /**
  * @brief Match using the Matchers::Be matcher, testing for falsy-ness.
  *
@@ -199,7 +237,7 @@ void Expectation<A>::to_be_falsy(std::string msg) {
  */
 template <typename A>
 void Expectation<A>::to_be_null(std::string msg) {
-  Matchers::BeNullptr<A>(*this).set_message(std::move(msg)).run();
+  check(Matchers::BeNullptr<A>(*this), std::move(msg));
 }
 
 /**
@@ -243,19 +281,19 @@ void Expectation<A>::to_be_truthy(std::string msg) {
 template <typename A>
 template <typename E>
 void Expectation<A>::to_be_between(E min, E max, Matchers::RangeMode mode, std::string msg) {
-  Matchers::BeBetween<A, E>(*this, min, max, mode).set_message(std::move(msg)).run();
+  check(Matchers::BeBetween<A, E>(*this, min, max, mode), std::move(msg));
 }
 
 template <typename A>
 template <typename E>
 void Expectation<A>::to_be_less_than(E rhs, std::string msg) {
-  Matchers::BeLessThan<A, E>(*this, rhs).set_message(std::move(msg)).run();
+  check(Matchers::BeLessThan<A, E>(*this, rhs), std::move(msg));
 }
 
 template <typename A>
 template <typename E>
 void Expectation<A>::to_be_greater_than(E rhs, std::string msg) {
-  Matchers::BeGreaterThan<A, E>(*this, rhs).set_message(std::move(msg)).run();
+  check(Matchers::BeGreaterThan<A, E>(*this, rhs), std::move(msg));
 }
 
 /**
@@ -269,7 +307,7 @@ void Expectation<A>::to_be_greater_than(E rhs, std::string msg) {
 template <typename A>
 template <typename U>
 void Expectation<A>::to_contain(std::initializer_list<U> expected, std::string msg) {
-  Matchers::Contain<A, std::vector<U>, U>(*this, expected).set_message(std::move(msg)).run();
+  check(Matchers::Contain<A, std::vector<U>, U>(*this, expected), std::move(msg));
 }
 
 /**
@@ -283,7 +321,7 @@ void Expectation<A>::to_contain(std::initializer_list<U> expected, std::string m
 template <typename A>
 template <typename E>
 void Expectation<A>::to_contain(E expected, std::string msg) {
-  Matchers::Contain<A, E, E>(*this, expected).set_message(std::move(msg)).run();
+  check(Matchers::Contain<A, E, E>(*this, expected), std::move(msg));
 }
 
 /**
@@ -297,7 +335,7 @@ void Expectation<A>::to_contain(E expected, std::string msg) {
 template <typename A>
 template <typename E>
 void Expectation<A>::to_equal(E expected, std::string msg) {
-  Matchers::Equal<A, E>(*this, expected).set_message(std::move(msg)).run();
+  check(Matchers::Equal<A, E>(*this, expected), std::move(msg));
 }
 
 /**
@@ -319,33 +357,47 @@ Matchers::BeWithinHelper<A, E> Expectation<A>::to_be_within(E expected, std::str
 template <typename A>
 void Expectation<A>::to_fail(std::string msg) {
   static_assert(is_result_v<A>, ".to_fail() must be used on an expression that returns a Result.");
-  Matchers::Fail<Result>(*this).set_message(std::move(msg)).run();
+  check(Matchers::Fail<Result>(*this), std::move(msg));
 }
 
 template <typename A>
 void Expectation<A>::to_fail_with(std::string failure_message, std::string msg) {
   static_assert(is_result_v<A>, ".to_fail_with() must be used on an expression that returns a Result.");
-  Matchers::FailWith<A>(*this, failure_message).set_message(std::move(msg)).run();
+  check(Matchers::FailWith<A>(*this, failure_message), std::move(msg));
 }
 
 template <typename A>
 void Expectation<A>::to_match(std::string str, std::string msg) {
-  Matchers::Match<A>(*this, str).set_message(std::move(msg)).run();
+  check(Matchers::Match<A>(*this, Matchers::Pattern(std::move(str))), std::move(msg));
 }
 
 template <typename A>
 void Expectation<A>::to_match(std::regex regex, std::string msg) {
-  Matchers::Match<A>(*this, regex).set_message(std::move(msg)).run();
+  check(Matchers::Match<A>(*this, Matchers::Pattern(std::move(regex))), std::move(msg));
+}
+
+/**
+ * @brief Match using the Matchers::Match matcher, with a pattern known at
+ * compile time.
+ *
+ * @code
+ *   expect(name).to_match<"[a-z]+">();
+ * @endcode
+ */
+template <typename A>
+template <Util::fixed_string Source>
+void Expectation<A>::to_match(std::string msg) {
+  check(Matchers::Match<A>(*this, Matchers::Pattern::of<Source>()), std::move(msg));
 }
 
 template <typename A>
 void Expectation<A>::to_partially_match(std::string str, std::string msg) {
-  Matchers::MatchPartial<A>(*this, str).set_message(std::move(msg)).run();
+  check(Matchers::MatchPartial<A>(*this, Matchers::Pattern(std::move(str))), std::move(msg));
 }
 
 template <typename A>
 void Expectation<A>::to_partially_match(std::regex regex, std::string msg) {
-  Matchers::MatchPartial<A>(*this, regex).set_message(std::move(msg)).run();
+  check(Matchers::MatchPartial<A>(*this, Matchers::Pattern(std::move(regex))), std::move(msg));
 }
 
 /**
@@ -361,40 +413,40 @@ template <typename A>
 template <typename F>
   requires std::invocable<F, A> && std::convertible_to<std::invoke_result_t<F, A>, bool>
 void Expectation<A>::to_satisfy(F test, std::string msg) {
-  Matchers::Satisfy<A>(*this, std::function<bool(A)>(std::move(test))).set_message(std::move(msg)).run();
+  check(Matchers::Satisfy<A>(*this, std::function<bool(A)>(std::move(test))), std::move(msg));
 }
 
 template <typename A>
 void Expectation<A>::to_start_with(std::string start, std::string msg) {
-  Matchers::StartWith<std::string, std::string>(*this, start).set_message(std::move(msg)).run();
+  check(Matchers::StartWith<std::string, std::string>(*this, start), std::move(msg));
 }
 
 template <typename A>
 template <typename U>
 void Expectation<A>::to_start_with(std::initializer_list<U> start_sequence, std::string msg) {
-  Matchers::StartWith<A, std::initializer_list<U>>(*this, start_sequence).set_message(std::move(msg)).run();
+  check(Matchers::StartWith<A, std::initializer_list<U>>(*this, start_sequence), std::move(msg));
 }
 
 template <typename A>
 void Expectation<A>::to_end_with(std::string ending, std::string msg) {
-  Matchers::EndWith<std::string, std::string>(*this, ending).set_message(std::move(msg)).run();
+  check(Matchers::EndWith<std::string, std::string>(*this, ending), std::move(msg));
 }
 
 template <typename A>
 template <typename U>
 void Expectation<A>::to_end_with(std::initializer_list<U> end_sequence, std::string msg) {
-  Matchers::EndWith<A, std::initializer_list<U>>(*this, end_sequence).set_message(std::move(msg)).run();
+  check(Matchers::EndWith<A, std::initializer_list<U>>(*this, end_sequence), std::move(msg));
 }
 
 template <typename A>
 void Expectation<A>::to_have_value(std::string msg) {
-  Matchers::HaveValue<A>(*this).set_message(std::move(msg)).run();
+  check(Matchers::HaveValue<A>(*this), std::move(msg));
 }
 
 #if __cpp_lib_expected
 template <typename A>
 void Expectation<A>::to_have_error(std::string msg) {
-  Matchers::HaveError<A>(*this).set_message(std::move(msg)).run();
+  check(Matchers::HaveError<A>(*this), std::move(msg));
 }
 #endif
 
@@ -444,10 +496,12 @@ class ExpectationFunc : public Expectation<decltype(std::declval<F>()())> {
   using block_ret_t = decltype(std::declval<F>()());
   F block;
   std::optional<block_ret_t> computed = std::nullopt;
+  std::size_t runs_ = 1;      // How many times timing matchers run the block
+  double percentile_ = 100;  // Which of those runs they compare, as a percentile
 
  public:
   ExpectationFunc(ExpectationFunc<F> const& copy, std::source_location location)
-      : Expectation<block_ret_t>(copy, location), block(copy.block) {}
+      : Expectation<block_ret_t>(copy, location), block(copy.block), runs_(copy.runs_), percentile_(copy.percentile_) {}
 
   /**
    * @brief Create an ExpectationValue using a value.
@@ -499,14 +553,55 @@ class ExpectationFunc : public Expectation<decltype(std::declval<F>()())> {
 
   Expectation<decltype(block())>& casted() { return static_cast<decltype(block())>(*this); }
 
+  /**
+   * @brief Run the block `runs` times in timing matchers such as
+   * to_complete_within, instead of once
+   *
+   * @code
+   *   expect(lookup).over(100).runs().at_p99().to_complete_within(5ms);
+   * @endcode
+   */
+  ExpectationFunc& over(std::size_t runs) {
+    runs_ = runs;
+    return *this;
+  }
+  ExpectationFunc& runs() { return *this; }  // Only there to read well
+
+  /** @brief Compare the given percentile of the runs' times, instead of the slowest */
+  ExpectationFunc& at_percentile(double percentile) {
+    percentile_ = percentile;
+    return *this;
+  }
+  ExpectationFunc& at_p50() { return at_percentile(50); }
+  ExpectationFunc& at_p90() { return at_percentile(90); }
+  ExpectationFunc& at_p99() { return at_percentile(99); }
+
   template <typename Ex = std::exception>
   void to_throw(std::string msg = "");
+
+  template <typename Rep, typename Period>
+  void to_complete_within(std::chrono::duration<Rep, Period> limit, std::string msg = "");
 };
 
 template <Util::is_functional F>
 template <typename Ex>
 void ExpectationFunc<F>::to_throw(std::string msg) {
-  Matchers::Throw<decltype(this->block.operator()()), Ex>(*this).set_message(std::move(msg)).run();
+  this->check(Matchers::Throw<decltype(this->block.operator()()), Ex>(*this), std::move(msg));
+}
+
+/**
+ * @brief Match using the Matchers::CompleteWithin matcher.
+ *
+ * @code
+ *   expect(parse).to_complete_within(5ms);
+ *   expect(parse).over(1000).runs().at_p99().to_complete_within(5ms);
+ * @endcode
+ */
+template <Util::is_functional F>
+template <typename Rep, typename Period>
+void ExpectationFunc<F>::to_complete_within(std::chrono::duration<Rep, Period> limit, std::string msg) {
+  this->check(Matchers::CompleteWithin<block_ret_t>(*this, limit, [this] { block(); }, runs_, percentile_),
+              std::move(msg));
 }
 
 }  // namespace CppSpec
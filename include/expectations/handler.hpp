@@ -12,6 +12,7 @@
 #include <exception>
 #include <string>
 
+#include "allocations.hpp"
 #include "result.hpp"
 
 namespace CppSpec {
@@ -44,11 +45,14 @@ Result PositiveExpectationHandler::handle_matcher(Matcher& matcher) {
   try {
     matched = matcher.match();
   } catch (std::exception& e) {
+    Allocations::Pause pause;  // The Result is kept by the example, not allocated by the code under test
     return Result::error_with(matcher.get_location(), e.what());
   } catch (...) {
+    Allocations::Pause pause;
     return Result::error_with(matcher.get_location(), "Unknown exception thrown during matcher execution.");
   }
 
+  Allocations::Pause pause;
   return !matched ? Result::failure_with(matcher.get_location(), matcher.failure_message())
                   : Result::success(matcher.get_location());
 }
@@ -67,10 +71,13 @@ Result NegativeExpectationHandler::handle_matcher(Matcher& matcher) {
   try {
     matched = matcher.negated_match();
   } catch (std::exception& e) {
+    Allocations::Pause pause;  // The Result is kept by the example, not allocated by the code under test
     return Result::error_with(matcher.get_location(), e.what());
   } catch (...) {
+    Allocations::Pause pause;
     return Result::error_with(matcher.get_location(), "Unhandled exception thrown during matcher execution.");
   }
+  Allocations::Pause pause;
   return !matched ? Result::failure_with(matcher.get_location(), matcher.failure_message_when_negated())
                   : Result::success(matcher.get_location());
 }
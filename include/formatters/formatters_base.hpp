@@ -46,6 +46,9 @@ class BaseFormatter {
   virtual ~BaseFormatter() = default;
 
   void format(const Runnable& runnable) {
+    if (!runnable.is_selected()) {
+      return;  // Not part of this run (e.g. in another shard)
+    }
     if (const auto* description = dynamic_cast<const Description*>(&runnable)) {
       format(*description);
     } else if (const auto* it = dynamic_cast<const ItBase*>(&runnable)) {
@@ -56,7 +59,7 @@ class BaseFormatter {
 
   void format_children(const Runnable& runnable) {
     for (const auto& child : runnable.get_children()) {
-      if (const auto* runnable = dynamic_cast<const Runnable*>(child.get())) {
+      if (const auto* runnable = dynamic_cast<const Runnable*>(child)) {
         this->format(*runnable);
       }
     }
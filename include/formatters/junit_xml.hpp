@@ -70,6 +70,15 @@ struct Result {
   }
 };
 
+struct Property {
+  std::string name;
+  std::string value;
+
+  [[nodiscard]] std::string to_xml() const {
+    return std::format(R"(        <property name="{}" value="{}"/>)", encode_xml(name), encode_xml(value));
+  }
+};
+
 struct TestCase {
   std::string name;
   std::string classname;
@@ -78,12 +87,13 @@ struct TestCase {
   std::list<Result> results;
   std::string file;
   std::size_t line;
+  std::list<Property> properties{};
 
   [[nodiscard]] std::string to_xml() const {
     auto start =
         std::format(R"(    <testcase name="{}" classname="{}" assertions="{}" time="{:f}" file="{}" line="{}")",
                     encode_xml(name), encode_xml(classname), assertions, time.count(), file, line);
-    if (results.empty()) {
+    if (results.empty() && properties.empty()) {
       return start + "/>";
     }
 
@@ -91,6 +101,13 @@ struct TestCase {
 
     std::stringstream ss;
     ss << start << ">" << std::endl;
+    if (!properties.empty()) {
+      ss << "      <properties>" << std::endl;
+      for (const Property& property : properties) {
+        ss << property.to_xml() << std::endl;
+      }
+      ss << "      </properties>";
+    }
 
     ss << std::accumulate(xml_results.begin(), xml_results.end(), std::string{},
                           [](const std::string& acc, const std::string& r) { return acc + "\n" + r; });
@@ -189,7 +206,9 @@ class JUnitXML : public BaseFormatter {
                         [](size_t sum, const JUnitNodes::TestSuite& suite) { return sum + suite.failures; });
     test_suites.time = std::ranges::fold_left(test_suites.suites, std::chrono::duration<double>(0),
                                               [](const auto& acc, const auto& suite) { return acc + suite.time; });
-    test_suites.timestamp = test_suites.suites.front().timestamp;
+    if (!test_suites.suites.empty()) {
+      test_suites.timestamp = test_suites.suites.front().timestamp;
+    }
 
     out_stream << std::fixed;  // disable scientific notation
     // out_stream << std::setprecision(6); // set precision to 6 decimal places
@@ -229,20 +248,12 @@ class JUnitXML : public BaseFormatter {
 
   void format(const ItBase& it) override {
     using namespace std::chrono;
-    std::forward_list<std::string> descriptions;
-
-    descriptions.push_front(it.get_description());
-    for (const auto* parent = it.get_parent_as<Description>(); parent->has_parent();
-         parent = parent->get_parent_as<Description>()) {
-      descriptions.push_front(parent->get_description());
-    }
-
-    std::string description = Util::join(descriptions, " ");
+    std::string description = it.get_full_description();
 
     auto test_case = JUnitNodes::TestCase{
         .name = description,
         .classname = "",
-        .assertions = it.get_results().size(),
+        .assertions = it.num_expectations(),
         .time = it.get_runtime(),
         .results = {},
         .file = it.get_location().file_name(),
@@ -257,6 +268,27 @@ class JUnitXML : public BaseFormatter {
                                      result.get_message());
     }
 
+    if (const auto& stats = it.get_benchmark_stats()) {
+      test_case.properties.insert(test_case.properties.end(),
+                                  {
+                                      {"benchmark.mean_ns", std::format("{:f}", stats->mean)},
+                                      {"benchmark.median_ns", std::format("{:f}", stats->median)},
+                                      {"benchmark.stddev_ns", std::format("{:f}", stats->stddev)},
+                                      {"benchmark.min_ns", std::format("{:f}", stats->min)},
+                                      {"benchmark.samples", std::to_string(stats->samples)},
+                                      {"benchmark.iterations", std::to_string(stats->iterations)},
+                                  });
+    }
+    if (const auto& allocations = it.get_allocations()) {
+      test_case.properties.insert(test_case.properties.end(),
+                                  {
+                                      {"allocations.count", std::to_string(allocations->allocations)},
+                                      {"allocations.bytes", std::to_string(allocations->bytes)},
+                                      {"allocations.leaked_bytes", std::to_string(allocations->live_bytes)},
+                                      {"allocations.leak_flagged", allocations->leaked() ? "true" : "false"},
+                                  });
+    }
+
     test_suites.suites.back().cases.push_back(test_case);
   }
 };
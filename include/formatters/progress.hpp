@@ -13,16 +13,19 @@ namespace CppSpec::Formatters {
 // The TAP format makes things a little tricky
 class Progress : public BaseFormatter {
   std::list<std::string> baked_failure_messages;
+  std::list<std::string> baked_benchmarks;
 
   std::string prep_failure_helper(const ItBase& it);
 
  public:
   ~Progress() override {
     format_failure_messages();  // Print any failures that we have
+    format_benchmarks();
   }
   void format(const ItBase& it) override;
 
   void format_failure_messages();
+  void format_benchmarks();
   void prep_failure(const ItBase& it);
 
   static char status_char(Result::Status status) {
@@ -103,6 +106,9 @@ inline void Progress::format(const ItBase& it) {
   if (it.get_result().status() == Result::Status::Failure) {
     prep_failure(it);
   }
+  if (const auto& stats = it.get_benchmark_stats()) {
+    baked_benchmarks.push_back(it.get_full_description() + ": " + stats->to_string());
+  }
   get_and_increment_test_counter();
 }
 
@@ -120,6 +126,17 @@ inline void Progress::format_failure_messages() {
   baked_failure_messages.clear();  // Finally, clear the failures list.
 }
 
+inline void Progress::format_benchmarks() {
+  if (baked_benchmarks.empty()) {
+    return;
+  }
+  out_stream << std::endl << "Benchmarks:" << std::endl;
+  for (const std::string& benchmark : baked_benchmarks) {
+    out_stream << "  " << benchmark << std::endl;
+  }
+  baked_benchmarks.clear();
+}
+
 static Progress progress;
 
 }  // namespace CppSpec::Formatters
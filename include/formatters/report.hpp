@@ -0,0 +1,159 @@
+/**
+ * @file
+ * @brief A machine-readable report of a run, for cppspec-run to merge
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "formatters_base.hpp"
+#include "it_base.hpp"
+#include "serialization.hpp"
+
+namespace CppSpec::Formatters {
+
+/*
+ * A report is a sequence of records, one for every top-level spec followed
+ * by one for each of its examples, in the order they're formatted:
+ *
+ *   'S' <name> <file> <start time> <runtime>
+ *   'E' <full description> <file> <line> <runtime> <success count> <result count> <results...>
+ *
+ * Unlike the trees sent back by forked workers (see isolation.hpp), a report
+ * is self-contained: it's read by another binary, which has neither the
+ * Runnables nor the source locations it was written from.
+ */
+namespace ReportNodes {
+constexpr char suite_record = 'S';
+constexpr char example_record = 'E';
+
+struct Result {
+  CppSpec::Result::Status status = CppSpec::Result::Status::Success;
+  std::string location;  // FILE:LINE:COLUMN
+  std::string message;
+  std::string type;
+};
+
+struct Example {
+  std::string description;
+  std::string file;
+  std::uint32_t line = 0;
+  std::chrono::duration<double> runtime{};
+  std::uint64_t successes = 0;
+  std::vector<Result> results;  // Other than successes
+
+  [[nodiscard]] CppSpec::Result::Status status() const {
+    // Reduced the way Result::reduce does: failures first, then errors
+    using enum CppSpec::Result::Status;
+    for (auto status : {Failure, Error, Success, Skipped}) {
+      for (const Result& result : results) {
+        if (result.status == status) {
+          return status;
+        }
+      }
+    }
+    return Success;
+  }
+};
+
+struct Suite {
+  std::string name;
+  std::string file;
+  std::chrono::time_point<std::chrono::system_clock> start_time;
+  std::chrono::duration<double> runtime{};
+  std::vector<Example> examples;
+};
+
+/**
+ * @brief Read the suites in a report.
+ * @return false if the report is cut short or malformed, keeping the suites read until then
+ */
+inline bool read(std::string_view report, std::vector<Suite>& suites) {
+  using namespace std::chrono;
+  Serialization::Reader in{report};
+  while (!in.empty()) {
+    char tag = 0;
+    double runtime = 0;
+    in.read(tag);
+    if (tag == suite_record) {
+      Suite suite;
+      system_clock::rep start_time = 0;
+      if (!in.read_string(suite.name) || !in.read_string(suite.file) || !in.read(start_time) || !in.read(runtime)) {
+        return false;
+      }
+      suite.start_time = system_clock::time_point{system_clock::duration{start_time}};
+      suite.runtime = duration<double>{runtime};
+      suites.push_back(std::move(suite));
+    } else if (tag == example_record && !suites.empty()) {
+      Example example;
+      std::uint64_t count = 0;
+      if (!in.read_string(example.description) || !in.read_string(example.file) || !in.read(example.line) ||
+          !in.read(runtime) || !in.read(example.successes) || !in.read(count)) {
+        return false;
+      }
+      example.runtime = duration<double>{runtime};
+      for (std::uint64_t i = 0; i < count; ++i) {
+        Result& result = example.results.emplace_back();
+        if (!in.read(result.status) || !in.read_string(result.location) || !in.read_string(result.message) ||
+            !in.read_string(result.type)) {
+          return false;
+        }
+      }
+      suites.back().examples.push_back(std::move(example));
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace ReportNodes
+
+/**
+ * @brief Writes a report of every example's results, as read by
+ * ReportNodes::read. Used by `--report` to pass results to cppspec-run.
+ */
+class Report : public BaseFormatter {
+ public:
+  explicit Report(std::ostream& out_stream) : BaseFormatter(out_stream, false) {}
+
+  void format(const Description& description) override;
+  void format(const ItBase& it) override;
+};
+
+inline void Report::format(const Description& description) {
+  if (description.has_parent()) {
+    return;
+  }
+  Serialization::Writer out;
+  out.write(ReportNodes::suite_record);
+  out.write_string(description.get_description());
+  out.write_string(description.get_location().file_name());
+  out.write(description.get_start_time().time_since_epoch().count());
+  out.write(description.get_runtime().count());
+  out_stream << out.str() << std::flush;
+}
+
+inline void Report::format(const ItBase& it) {
+  Serialization::Writer out;
+  out.write(ReportNodes::example_record);
+  out.write_string(it.get_full_description());
+  out.write_string(it.get_location().file_name());
+  out.write(std::uint32_t{it.get_location().line()});
+  out.write(it.get_runtime().count());
+  out.write(std::uint64_t{it.get_success_count()});
+  out.write(std::uint64_t{it.get_results().size()});
+  for (const Result& result : it.get_results()) {
+    out.write(result.status());
+    out.write_string(result.get_location_string());
+    out.write_string(result.get_message());
+    out.write_string(result.get_type());
+  }
+  out_stream << out.str() << std::flush;
+}
+
+}  // namespace CppSpec::Formatters
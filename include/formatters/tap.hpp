@@ -90,23 +90,16 @@ inline void TAP::format(const Description& description) {
 }
 
 inline void TAP::format(const ItBase& it) {
-  // Build up the description for the test by ascending the
-  // execution tree and chaining the individual descriptions together
-  std::forward_list<std::string> descriptions;
-
-  descriptions.push_front(it.get_description());
-  for (const auto* parent = it.get_parent_as<Description>(); parent->has_parent();
-       parent = parent->get_parent_as<Description>()) {
-    descriptions.push_front(parent->get_description());
-  }
-
-  std::string description = Util::join(descriptions, " ");
+  std::string description = it.get_full_description();
 
   buffer << status_color(it.get_result().status());
   buffer << (it.get_result().is_success() ? "ok" : "not ok");
   buffer << reset_color();
   buffer << " " << get_and_increment_test_counter() << " - " << description << std::endl;
   buffer << result_to_yaml(it.get_result());
+  if (const auto& stats = it.get_benchmark_stats()) {
+    buffer << "# " << stats->to_string() << std::endl;
+  }
 }
 
 static TAP tap;
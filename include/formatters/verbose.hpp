@@ -34,6 +34,16 @@ inline void Verbose::format(const ItBase& it) {
   out_stream << status_color(it.get_result().status());
   out_stream << it.padding() << it.get_description() << std::endl;
   out_stream << reset_color();
+  if (const auto& stats = it.get_benchmark_stats()) {
+    out_stream << it.padding() << "  " << stats->to_string() << std::endl;
+  }
+  if (const auto& allocations = it.get_allocations()) {
+    out_stream << it.padding() << "  " << allocations->to_string();
+    if (allocations->leaked()) {
+      out_stream << set_color(YELLOW) << " (flagged: possible leak)" << reset_color();
+    }
+    out_stream << std::endl;
+  }
 
   // Print any failures if we've got them
   // 'it' having a bad status necessarily
@@ -0,0 +1,563 @@
+/**
+ * @file
+ * @brief Running specs in forked worker processes
+ */
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <optional>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+extern "C" {
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+#include "description.hpp"
+#include "serialization.hpp"
+
+namespace CppSpec::Isolation {
+
+/*
+ * A child writes a record to its pipe whenever an example with a timeout
+ * starts or finishes, so that the parent can kill it if that example hangs,
+ * and the results of every example as soon as it has finished, so that they
+ * survive the child being killed. Once its spec has finished, it writes the
+ * serialized tree:
+ *
+ *   'S' <example index> <timeout in seconds>
+ *   'F' <example index>
+ *   'R' <example index> <serialized example, as a string>
+ *   'T' <tree>
+ *
+ * Examples are identified by their index in a pre-order walk of the tree.
+ */
+constexpr char started_record = 'S';
+constexpr char finished_record = 'F';
+constexpr char results_record = 'R';
+constexpr char tree_record = 'T';
+
+// A forked child shares its parent's address space layout, so a
+// source_location (which only points at static data in the binary) means
+// the same thing on both sides of the pipe and can be copied as is.
+static_assert(std::is_trivially_copyable_v<std::source_location>);
+
+using Serialization::Reader;
+using Serialization::Writer;
+
+/**
+ * @brief Write out the timings and results of a tree that has been run.
+ *
+ * Runnables are written in tree order, so that deserialize() can walk the
+ * parent's (identical) tree in step. Those that were deselected while
+ * running (e.g. by `--fail-fast`) are only written as such.
+ */
+inline void serialize(const Runnable& runnable, Writer& out) {
+  out.write(runnable.is_selected());
+  if (!runnable.is_selected()) {
+    return;
+  }
+  out.write(runnable.get_start_time().time_since_epoch().count());
+  out.write(runnable.get_runtime().count());
+  if (const auto* it = dynamic_cast<const ItBase*>(&runnable)) {
+    out.write_string(it->get_description());  // Generated while running if it wasn't given one
+    out.write(std::uint64_t{it->get_success_count()});
+    out.write(std::uint64_t{it->get_results().size()});
+    for (const Result& result : it->get_results()) {
+      out.write(result.status());
+      out.write(result.get_location());
+      out.write_string(result.get_message());
+      out.write_string(result.get_type());
+    }
+    out.write(it->get_benchmark_stats().has_value());
+    if (const auto& stats = it->get_benchmark_stats()) {
+      out.write(*stats);
+    }
+    out.write(it->get_allocations().has_value());
+    if (const auto& allocations = it->get_allocations()) {
+      out.write(*allocations);
+    }
+  }
+  for (const auto& child : runnable.get_children()) {
+    serialize(*child, out);
+  }
+}
+
+inline Result make_result(Result::Status status, std::source_location location, std::string message) {
+  switch (status) {
+    case Result::Status::Success:
+      return Result::success_with(location, std::move(message));
+    case Result::Status::Failure:
+      return Result::failure_with(location, std::move(message));
+    case Result::Status::Error:
+      return Result::error_with(location, std::move(message));
+    case Result::Status::Skipped:
+      return Result::skipped_with(location, std::move(message));
+  }
+  return Result::error_with(location, std::move(message));
+}
+
+/**
+ * @brief Fill in the timings and results of a tree from a serialized copy.
+ * @return whether the whole tree could be read
+ */
+inline bool deserialize(Runnable& runnable, Reader& in) {
+  using namespace std::chrono;
+  bool selected = false;
+  if (!in.read(selected)) {
+    return false;
+  }
+  runnable.set_selected(selected);
+  if (!selected) {
+    return true;
+  }
+
+  system_clock::rep start_time = 0;
+  double runtime = 0;
+  if (!in.read(start_time) || !in.read(runtime)) {
+    return false;
+  }
+  runnable.set_start_time(system_clock::time_point{system_clock::duration{start_time}});
+  runnable.set_runtime(duration<double>{runtime});
+
+  if (auto* it = dynamic_cast<ItBase*>(&runnable)) {
+    std::string description;
+    std::uint64_t successes = 0;
+    std::uint64_t count = 0;
+    if (!in.read_string(description) || !in.read(successes) || !in.read(count)) {
+      return false;
+    }
+    it->set_description(description);
+    it->clear_results();
+    it->add_successes(successes);
+    for (std::uint64_t i = 0; i < count; ++i) {
+      Result::Status status{};
+      std::source_location location;
+      std::string message;
+      std::string type;
+      if (!in.read(status) || !in.read(location) || !in.read_string(message) || !in.read_string(type)) {
+        return false;
+      }
+      Result result = make_result(status, location, std::move(message));
+      result.set_type(std::move(type));
+      it->add_result(result);
+    }
+    bool has_stats = false;
+    if (!in.read(has_stats)) {
+      return false;
+    }
+    if (has_stats) {
+      BenchmarkStats stats;
+      if (!in.read(stats)) {
+        return false;
+      }
+      it->set_benchmark_stats(stats);
+    }
+    bool has_allocations = false;
+    if (!in.read(has_allocations)) {
+      return false;
+    }
+    if (has_allocations) {
+      AllocationStats allocations;
+      if (!in.read(allocations)) {
+        return false;
+      }
+      it->set_allocations(allocations);
+    }
+  }
+
+  for (auto& child : runnable.get_children()) {
+    if (!deserialize(*child, in)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Replace the results of every example in a tree with an error,
+ * other than those in `finished`.
+ */
+inline void mark_errored(Runnable& runnable,
+                         const std::string& message,
+                         const std::unordered_set<const Runnable*>& finished = {}) {
+  if (finished.contains(&runnable)) {
+    return;
+  }
+  if (auto* it = dynamic_cast<ItBase*>(&runnable)) {
+    it->clear_results();
+    it->add_result(Result::error_with(it->get_location(), message));
+  }
+  for (auto& child : runnable.get_children()) {
+    if (child->is_selected()) {
+      mark_errored(*child, message, finished);
+    }
+  }
+}
+
+/**
+ * @brief Count the examples in a tree that failed or errored.
+ */
+inline std::size_t count_failed(const Runnable& runnable) {
+  if (!runnable.is_selected()) {
+    return 0;
+  }
+  if (dynamic_cast<const ItBase*>(&runnable) != nullptr) {
+    Result result = runnable.get_result();
+    return result.is_failure() || result.is_error() ? 1 : 0;
+  }
+  std::size_t count = 0;
+  for (const auto& child : runnable.get_children()) {
+    count += count_failed(*child);
+  }
+  return count;
+}
+
+/**
+ * @brief Describe why a worker didn't send back a complete set of results.
+ */
+inline std::string describe_exit(int status) {
+  if (WIFSIGNALED(status)) {
+    return std::format("Spec process was killed by signal {} ({})", WTERMSIG(status), strsignal(WTERMSIG(status)));
+  }
+  if (WIFEXITED(status) && WEXITSTATUS(status) != 0) {
+    return std::format("Spec process exited with status {}", WEXITSTATUS(status));
+  }
+  return "Spec process exited without reporting all of its results";
+}
+
+/**
+ * @brief List every Runnable in a tree, in pre-order.
+ */
+inline void preorder(Runnable& runnable, std::vector<Runnable*>& nodes) {
+  nodes.push_back(&runnable);
+  for (auto& child : runnable.get_children()) {
+    preorder(*child, nodes);
+  }
+}
+
+/**
+ * @brief An example (with a timeout) that a worker is currently running.
+ *
+ * A worker may be running several at once, when they are asynchronous.
+ */
+struct TimedExample {
+  std::uint64_t index;
+  std::chrono::steady_clock::time_point deadline;
+  RunControl::Seconds timeout;
+};
+
+/**
+ * @brief A child process running a single top-level spec.
+ */
+struct Worker {
+  Description* spec = nullptr;
+  pid_t pid = -1;
+  int fd = -1;  // The read end of the pipe the child writes its results to
+  std::string buffer;
+  std::size_t parsed = 0;                        // How much of `buffer` has been read as records
+  std::optional<std::size_t> tree_start;         // Where in `buffer` the serialized tree starts
+  std::vector<Runnable*> nodes;                  // The spec's tree, in pre-order
+  std::vector<TimedExample> running;             // The examples with a timeout that are running
+  std::optional<TimedExample> timed_out;         // The example the child was killed for
+  std::unordered_set<const Runnable*> finished;  // The examples whose results have been sent back
+};
+
+inline void write_all(int fd, std::string_view data) {
+  while (!data.empty()) {
+    ssize_t written = ::write(fd, data.data(), data.size());
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data.remove_prefix(static_cast<std::size_t>(written));
+  }
+}
+
+/**
+ * @brief The body of a child process: run the spec and report back over `fd`.
+ */
+[[noreturn]] inline void run_child(Description& spec, const std::vector<Runnable*>& nodes, int fd) {
+  std::unordered_map<const Runnable*, std::uint64_t> indices;
+  for (std::uint64_t i = 0; i < nodes.size(); ++i) {
+    indices[nodes[i]] = i;
+  }
+
+  // This is the child's own copy of the RunControl, so the parent's is untouched
+  if (RunControl* control = spec.get_run_control()) {
+    control->on_timed_start = [&indices, fd](const ItBase& it, RunControl::Seconds timeout) {
+      Writer out;
+      out.write(started_record);
+      out.write(indices.at(&it));
+      out.write(timeout.count());
+      write_all(fd, out.str());
+    };
+    control->on_timed_finish = [&indices, fd](const ItBase& it) {
+      Writer out;
+      out.write(finished_record);
+      out.write(indices.at(&it));
+      write_all(fd, out.str());
+    };
+    control->on_finished = [&indices, fd](const ItBase& it) {
+      Writer example;
+      serialize(it, example);
+      Writer out;
+      out.write(results_record);
+      out.write(indices.at(&it));
+      out.write_string(example.str());
+      write_all(fd, out.str());
+    };
+  }
+
+  spec.timed_run();
+  Writer out;
+  out.write(tree_record);
+  serialize(spec, out);
+  write_all(fd, out.str());
+  ::close(fd);
+
+  // _exit doesn't flush, so whatever the examples printed would be lost
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+  ::_exit(0);  // Skip static destructors, such as those of the global formatters
+}
+
+/**
+ * @brief Fork a child that runs the Worker's spec and writes back its results.
+ * @return whether the child could be started
+ */
+inline bool start(Worker& worker) {
+  int fds[2];
+  if (::pipe(fds) != 0) {
+    return false;
+  }
+  preorder(*worker.spec, worker.nodes);
+
+  // Don't let the child inherit (and later repeat) anything still buffered
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+  pid_t pid = ::fork();
+  if (pid < 0) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    return false;
+  }
+
+  if (pid == 0) {
+    ::close(fds[0]);
+    run_child(*worker.spec, worker.nodes, fds[1]);
+  }
+
+  ::close(fds[1]);
+  worker.pid = pid;
+  worker.fd = fds[0];
+  return true;
+}
+
+/**
+ * @brief Read the start/finish and results records a Worker has sent so far,
+ * up to its tree. Each example's results are copied into the parent's tree
+ * as they arrive.
+ */
+inline void read_records(Worker& worker) {
+  while (!worker.tree_start && worker.parsed < worker.buffer.size()) {
+    Reader in{std::string_view{worker.buffer}.substr(worker.parsed)};
+    char tag = 0;
+    in.read(tag);
+    if (tag == tree_record) {
+      worker.tree_start = worker.parsed + 1;
+      return;
+    }
+
+    std::uint64_t index = 0;
+    if (!in.read(index)) {
+      return;  // Wait for the rest of the record
+    }
+    if (tag == started_record) {
+      double timeout = 0;
+      if (!in.read(timeout)) {
+        return;
+      }
+      auto seconds = RunControl::Seconds{timeout};
+      auto deadline = std::chrono::steady_clock::now() +
+                      std::chrono::duration_cast<std::chrono::steady_clock::duration>(seconds);
+      worker.running.push_back(TimedExample{.index = index, .deadline = deadline, .timeout = seconds});
+    } else if (tag == results_record) {
+      std::string example;
+      if (!in.read_string(example)) {
+        return;
+      }
+      Reader results{example};
+      if (index < worker.nodes.size() && deserialize(*worker.nodes[index], results)) {
+        worker.finished.insert(worker.nodes[index]);
+      }
+    } else {
+      std::erase_if(worker.running, [index](const TimedExample& example) { return example.index == index; });
+    }
+    worker.parsed = worker.buffer.size() - in.remaining();
+  }
+}
+
+/**
+ * @brief Read whatever a Worker has written so far.
+ * @return false once the child has closed its end of the pipe
+ */
+inline bool read_some(Worker& worker) {
+  char chunk[4096];
+  ssize_t count = ::read(worker.fd, chunk, sizeof(chunk));
+  if (count > 0) {
+    worker.buffer.append(chunk, static_cast<std::size_t>(count));
+    read_records(worker);
+    return true;
+  }
+  return count < 0 && errno == EINTR;
+}
+
+/**
+ * @brief Kill a Worker one of whose examples has run past its timeout.
+ */
+inline void enforce_timeout(Worker& worker, std::chrono::steady_clock::time_point now) {
+  if (worker.timed_out) {
+    return;
+  }
+  for (const TimedExample& example : worker.running) {
+    if (now >= example.deadline) {
+      worker.timed_out = example;
+      ::kill(worker.pid, SIGKILL);  // Its pipe then closes, and it's reaped by finish()
+      return;
+    }
+  }
+}
+
+/**
+ * @brief How long poll() may wait before a Worker's example runs out of time.
+ * @return the time in milliseconds, or -1 to wait indefinitely
+ */
+inline int poll_timeout(const std::vector<Worker>& workers, std::chrono::steady_clock::time_point now) {
+  int wait = -1;
+  for (const Worker& worker : workers) {
+    if (worker.timed_out) {
+      continue;
+    }
+    for (const TimedExample& example : worker.running) {
+      auto left = std::chrono::ceil<std::chrono::milliseconds>(example.deadline - now).count();
+      int ms = static_cast<int>(std::clamp<decltype(left)>(left, 0, std::numeric_limits<int>::max()));
+      wait = wait < 0 ? ms : std::min(wait, ms);
+    }
+  }
+  return wait;
+}
+
+/**
+ * @brief Reap a Worker's child and copy its results into the parent's tree.
+ */
+inline void finish(Worker& worker, RunControl& control) {
+  ::close(worker.fd);
+  int status = 0;
+  while (::waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {
+  }
+
+  if (worker.timed_out) {
+    // The examples that finished keep their results; the rest never got to run
+    worker.spec->set_selected(true);
+    mark_errored(*worker.spec, "Not run: the spec process was killed after an example timed out", worker.finished);
+    if (auto* it = dynamic_cast<ItBase*>(worker.nodes.at(worker.timed_out->index))) {
+      auto message = std::format("Timed out after {}s", worker.timed_out->timeout.count());
+      it->clear_results();
+      it->add_result(Result::error_with(it->get_location(), message));
+      it->set_runtime(worker.timed_out->timeout);
+    }
+  } else {
+    bool clean_exit = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    std::string_view tree = worker.tree_start ? std::string_view{worker.buffer}.substr(*worker.tree_start) : "";
+    Reader in{tree};
+    if (!clean_exit || !worker.tree_start || !deserialize(*worker.spec, in) || !in.empty()) {
+      worker.spec->set_selected(true);  // A partial read may have deselected it
+      mark_errored(*worker.spec, describe_exit(status));
+    }
+  }
+  control.record_failures(count_failed(*worker.spec));
+}
+
+/**
+ * @brief Run every selected spec in a child process of its own, with up to
+ * `jobs` of them running at the same time.
+ *
+ * A spec that crashes (or otherwise dies) only takes down its own process;
+ * each of its examples is then reported as an error. A process whose
+ * current example runs past its timeout is killed in the same way. Once
+ * `control` says to stop, no more processes are started and the remaining
+ * specs are deselected.
+ */
+inline void run(const std::list<Description*>& specs, std::size_t jobs, RunControl& control) {
+  std::vector<Worker> workers;
+  auto next = specs.begin();
+
+  while (next != specs.end() || !workers.empty()) {
+    while (workers.size() < jobs && next != specs.end()) {
+      Worker worker{.spec = *next++};
+      if (!worker.spec->is_selected()) {
+        continue;
+      }
+      if (control.stopped()) {
+        worker.spec->set_selected(false);
+        continue;
+      }
+      if (start(worker)) {
+        workers.push_back(std::move(worker));
+      } else {
+        mark_errored(*worker.spec, std::format("Could not start a spec process: {}", std::strerror(errno)));
+      }
+    }
+    if (workers.empty()) {
+      continue;
+    }
+
+    std::vector<pollfd> fds;
+    fds.reserve(workers.size());
+    for (const Worker& worker : workers) {
+      fds.push_back({.fd = worker.fd, .events = POLLIN, .revents = 0});
+    }
+    int ready = ::poll(fds.data(), fds.size(), poll_timeout(workers, std::chrono::steady_clock::now()));
+
+    auto now = std::chrono::steady_clock::now();
+    for (Worker& worker : workers) {
+      enforce_timeout(worker, now);
+    }
+    if (ready <= 0) {
+      continue;  // Interrupted or timed out, try again
+    }
+
+    // Walk backwards so that erasing a Worker doesn't move the ones still to be checked
+    for (std::size_t i = workers.size(); i-- > 0;) {
+      if (fds[i].revents != 0 && !read_some(workers[i])) {
+        finish(workers[i], control);
+        workers.erase(workers.begin() + static_cast<std::ptrdiff_t>(i));
+      }
+    }
+  }
+}
+
+}  // namespace CppSpec::Isolation
@@ -27,10 +27,13 @@ namespace CppSpec {
 class ItD : public ItBase {
  public:
   using Block = std::function<void(ItD&)>;
+  using AsyncBlock = std::function<Task(ItD&)>;
 
  private:
   /** @brief The block contained in the ItD */
-  const Block block;
+  Block block;
+  /** @brief The coroutine contained in the ItD, if it is asynchronous */
+  AsyncBlock async_block;
 
  public:
   /**
@@ -71,8 +74,26 @@ class ItD : public ItBase {
    */
   ItD(std::source_location location, Block block) : ItBase(location), block(block) {}
 
+  /**
+   * @brief The asynchronous ItD constructors
+   *
+   * @code
+   *   it("should answer", _async { co_await CppSpec::sleep_for(10ms); ... });
+   * @endcode
+   */
+  ItD(std::source_location location, const char* description, AsyncBlock block)
+      : ItBase(location, description), async_block(std::move(block)) {}
+  ItD(std::source_location location, AsyncBlock block) : ItBase(location), async_block(std::move(block)) {}
+
+  [[nodiscard]] bool is_async() const noexcept override { return static_cast<bool>(async_block); }
+
+  // Swap in the block declared when the describe body is run again (see Description::run)
+  void rebind(Block block) noexcept { this->block = std::move(block); }
+  void rebind(AsyncBlock block) noexcept { async_block = std::move(block); }
+
   // implemented in description.hpp
   void run() override;
+  Task run_async() override;
 };
 
 /**
@@ -89,10 +110,13 @@ template <typename T>
 class ItCD : public ItBase {
  public:
   using Block = std::function<void(ItCD<T>&)>;
+  using AsyncBlock = std::function<Task(ItCD<T>&)>;
 
  private:
   /** @brief The block contained in the ItCD */
-  const Block block;
+  Block block;
+  /** @brief The coroutine contained in the ItCD, if it is asynchronous */
+  AsyncBlock async_block;
 
  public:
   /**
@@ -110,10 +134,23 @@ class ItCD : public ItBase {
 
   ItCD(std::source_location location, T& subject, Block block) : ItBase(location), block(block), subject(subject) {}
 
+  ItCD(std::source_location location, T& subject, const char* description, AsyncBlock block)
+      : ItBase(location, description), async_block(std::move(block)), subject(subject) {}
+
+  ItCD(std::source_location location, T& subject, AsyncBlock block)
+      : ItBase(location), async_block(std::move(block)), subject(subject) {}
+
   ExpectationValue<T> is_expected(std::source_location location = std::source_location::current()) {
     return {*this, subject, location};
   }
+  [[nodiscard]] bool is_async() const noexcept override { return static_cast<bool>(async_block); }
+
+  // Swap in the block declared when the describe body is run again (see Description::run)
+  void rebind(Block block) noexcept { this->block = std::move(block); }
+  void rebind(AsyncBlock block) noexcept { async_block = std::move(block); }
+
   void run() override;
+  Task run_async() override;
 };
 
 /**
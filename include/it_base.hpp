@@ -2,12 +2,17 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <numeric>
+#include <optional>
 #include <source_location>
 #include <string>
 #include <utility>
 
+#include "allocations.hpp"
+#include "async.hpp"
+#include "benchmark.hpp"
 #include "let.hpp"
 #include "runnable.hpp"
 #include "util.hpp"
@@ -31,8 +36,16 @@ class ExpectationFunc;
  */
 class ItBase : public Runnable {
   /** @brief The documentation string for this `it` */
-  std::string description;
-  std::list<Result> results;  // The results of the `it` statement
+  mutable std::string description;
+  // Generates the description the first time it's asked for (see defer_description)
+  mutable std::function<std::string()> describe_;
+  std::list<Result> results;  // The results of the `it` statement, other than successes
+  std::size_t successes_ = 0;  // Passing expectations are only counted
+  std::optional<std::chrono::duration<double>> timeout_;
+  std::optional<BenchmarkOptions> benchmark_;
+  std::optional<BenchmarkStats> benchmark_stats_;
+  std::optional<std::size_t> measured_from_;  // While a benchmark is measured, how many results it had
+  std::optional<AllocationStats> allocations_;
 
  public:
   ItBase() = delete;  // Don't allow a default constructor
@@ -55,13 +68,27 @@ class ItBase : public Runnable {
    * @brief Get whether the object needs a description string
    * @return whether this object needs a description to be generated or not
    */
-  bool needs_description() noexcept { return description.empty(); }
+  bool needs_description() noexcept { return description.empty() && !describe_; }
 
   /**
-   * @brief Get the description string for the `it` statement
+   * @brief Get the description string for the `it` statement, generating it
+   * now if that was deferred
    * @return the description string
    */
-  [[nodiscard]] std::string get_description() const noexcept { return description; }
+  [[nodiscard]] std::string get_description() const {
+    if (describe_) {
+      description = describe_();
+      describe_ = nullptr;
+    }
+    return description;
+  }
+
+  /**
+   * @brief Get the description of this `it` prefixed by those of the
+   * Descriptions that contain it (not including the outermost one)
+   * @return the full description string
+   */
+  [[nodiscard]] std::string get_full_description() const;  // implemented in description.hpp
 
   /**
    * @brief Set the description string
@@ -69,6 +96,18 @@ class ItBase : public Runnable {
    */
   ItBase& set_description(std::string_view description) noexcept {
     this->description = description;
+    describe_ = nullptr;
+    return *this;
+  }
+
+  /**
+   * @brief Generate the description with `describe` when it's first asked
+   * for, rather than now. Examples whose description is never printed then
+   * never format one.
+   * @return a reference to the modified ItBase
+   */
+  ItBase& defer_description(std::function<std::string()> describe) noexcept {
+    describe_ = std::move(describe);
     return *this;
   }
 
@@ -132,10 +171,117 @@ class ItBase : public Runnable {
   ExpectationValue<std::string> expect(const char* string,
                                        std::source_location location = std::source_location::current());
 
-  void add_result(const Result& result) { results.push_back(result); }
+  /**
+   * @brief Give this example a time limit
+   *
+   * An example that runs for longer than this is reported as an error. See
+   * also Description::timeout and `--timeout`.
+   *
+   * @return a reference to the modified ItBase
+   */
+  ItBase& timeout(std::chrono::duration<double> timeout) noexcept {
+    timeout_ = timeout;
+    return *this;
+  }
+  [[nodiscard]] std::optional<std::chrono::duration<double>> get_timeout() const noexcept { return timeout_; }
+
+  /**
+   * @brief Whether the body of this `it` is a coroutine, to be run on an
+   * EventLoop together with its asynchronous siblings
+   */
+  [[nodiscard]] virtual bool is_async() const noexcept { return false; }
+
+  /**
+   * @brief Run this example as a Task; only meaningful when is_async()
+   *
+   * The caller installs the example's LetFrame and times it.
+   */
+  virtual Task run_async() {
+    run();
+    co_return;
+  }
+
+  /**
+   * @brief Make this example a benchmark: after running its body once to
+   * check its expectations, time it as set out by `options`
+   * @return a reference to the modified ItBase
+   */
+  ItBase& set_benchmark(const BenchmarkOptions& options) noexcept {
+    benchmark_ = options;
+    return *this;
+  }
+  [[nodiscard]] bool is_benchmark() const noexcept { return benchmark_.has_value(); }
+  [[nodiscard]] const std::optional<BenchmarkStats>& get_benchmark_stats() const noexcept { return benchmark_stats_; }
+  void set_benchmark_stats(const BenchmarkStats& stats) noexcept { benchmark_stats_ = stats; }
+
+  /**
+   * @brief Run the body of a benchmark once, then measure it if that passed.
+   *
+   * While measuring, successes aren't counted, so that thousands of
+   * iterations don't count thousands of them. Only the first failure is
+   * kept, and measuring stops soon after it, without any statistics.
+   */
+  template <typename F>
+  void run_benchmark(F body) {
+    body();
+    Result result = get_result();
+    if (result.is_failure() || result.is_error()) {
+      return;
+    }
+    struct Measuring {
+      std::optional<std::size_t>& from;
+      ~Measuring() { from.reset(); }
+    } restore{measured_from_};
+    measured_from_ = results.size();
+    Allocations::Pause pause;  // The first run has already been counted
+    benchmark_stats_ = measure(body, *benchmark_, [this] { return results.size() != *measured_from_; });
+  }
+
+  /**
+   * @brief The heap allocations this example made, if they were tracked
+   * (see allocations.hpp)
+   */
+  [[nodiscard]] const std::optional<AllocationStats>& get_allocations() const noexcept { return allocations_; }
+  void set_allocations(const AllocationStats& allocations) noexcept { allocations_ = allocations; }
+
+  /**
+   * @brief Run and time this example, counting its allocations if tracking
+   * is enabled.
+   */
+  void timed_run() override {
+    if constexpr (!Allocations::enabled) {
+      Runnable::timed_run();
+    } else {
+      Allocations::Scope scope{allocations_.emplace()};
+      Runnable::timed_run();
+    }
+  }
+
+  /**
+   * @brief Record the result of an expectation. Successes are only counted;
+   * failures, errors and skips are kept in full.
+   */
+  void add_result(const Result& result) {
+    if (result.is_success()) {
+      if (!measured_from_) {
+        ++successes_;
+      }
+    } else if (!measured_from_ || results.size() == *measured_from_) {
+      results.push_back(result);
+    }
+  }
+  void add_successes(std::size_t count) noexcept { successes_ += count; }
+
+  /** @brief The results other than successes, in the order they were added */
   std::list<Result>& get_results() noexcept { return results; }
   [[nodiscard]] const std::list<Result>& get_results() const noexcept { return results; }
-  void clear_results() noexcept { results.clear(); }
+  [[nodiscard]] std::size_t get_success_count() const noexcept { return successes_; }
+  /** @brief How many expectations have been checked, whatever their result */
+  [[nodiscard]] std::size_t num_expectations() const noexcept { return successes_ + results.size(); }
+  void clear_results() noexcept {
+    results.clear();
+    successes_ = 0;
+  }
 
   [[nodiscard]] Result get_result() const override {
     auto default_result = Result::success(this->get_location());
@@ -2,10 +2,74 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace CppSpec {
 
+class LetBase;
+
+/**
+ * @brief The memoized values of every Let used by one running example
+ *
+ * A Let belongs to a Description, but the value it memoizes belongs to a
+ * single example. Examples that run at the same time (on different
+ * threads) each install their own frame, so they never see each other's
+ * values. Dropping the frame when the example finishes resets all of its
+ * Lets at once.
+ */
+class LetFrame {
+  std::vector<std::pair<const LetBase*, std::shared_ptr<void>>> values;
+
+  static LetFrame*& current_frame() noexcept {
+    thread_local LetFrame* frame = nullptr;
+    return frame;
+  }
+
+ public:
+  LetFrame() = default;
+  LetFrame(const LetFrame&) = delete;
+  LetFrame& operator=(const LetFrame&) = delete;
+
+  /** @brief The frame of the example running on this thread, if any */
+  static LetFrame* current() noexcept { return current_frame(); }
+
+  /** @brief Installs a frame on this thread for as long as it is in scope */
+  class Scope {
+    LetFrame* previous;
+
+   public:
+    explicit Scope(LetFrame& frame) noexcept : previous(current_frame()) { current_frame() = &frame; }
+    ~Scope() { current_frame() = previous; }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+  [[nodiscard]] bool contains(const LetBase* let) const noexcept {
+    for (const auto& [key, value] : values) {
+      if (key == let) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename T, typename F>
+  T& get(const LetBase* let, F& factory) {
+    for (auto& [key, value] : values) {
+      if (key == let) {
+        return *static_cast<T*>(value.get());
+      }
+    }
+    auto value = std::make_shared<T>(factory());
+    T& ref = *value;
+    values.emplace_back(let, std::move(value));
+    return ref;
+  }
+};
+
 /**
  * @brief Base class for lets to abstract away the template arguments
  *
@@ -21,7 +85,10 @@ class LetBase {
   constexpr LetBase() noexcept = default;
   LetBase(const LetBase& copy) = default;
   void reset() noexcept { delivered = false; }
-  [[nodiscard]] constexpr bool has_result() const noexcept { return this->delivered; }
+  [[nodiscard]] bool has_result() const noexcept {
+    const LetFrame* frame = LetFrame::current();
+    return frame != nullptr ? frame->contains(this) : this->delivered;
+  }
 };
 
 /**
@@ -42,6 +109,9 @@ class Let : public LetBase {
  public:
   explicit Let(block_t body) noexcept : LetBase(), body(body) {}
 
+  // Swap in the body declared when the describe body is run again (see Description::run)
+  void rebind(block_t body) noexcept { this->body = std::move(body); }
+
   T* operator->() {
     return std::addressof(value());
   }
@@ -61,10 +131,17 @@ void Let<T>::exec() {
 
 /**
  * @brief Get the value contained in the Let
+ *
+ * Inside an example the value is memoized in that example's LetFrame.
+ * Outside of one (e.g. in a before_all) it is memoized in the Let itself.
+ *
  * @return a reference to the returned object of the let statement
  */
 template <typename T>
 T& Let<T>::value() & {
+  if (LetFrame* frame = LetFrame::current()) {
+    return frame->get<T>(this, body);
+  }
   exec();
   return result.value();
 }
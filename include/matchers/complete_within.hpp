@@ -0,0 +1,100 @@
+/** @file */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "matchers/matcher_base.hpp"
+#include "util.hpp"
+
+namespace CppSpec::Matchers {
+
+/**
+ * @brief Matches a function that runs in less than a time limit.
+ *
+ * The function is run `runs` times, and the given percentile of the times it
+ * took (the slowest, by default) is compared against the limit.
+ */
+template <class A>
+class CompleteWithin : public MatcherBase<A, std::chrono::duration<double>> {
+  std::function<void()> block;
+  std::size_t runs;
+  double percentile;
+  std::vector<double> times;  // In nanoseconds, sorted
+
+  [[nodiscard]] double at(double p) const {
+    // Nearest-rank percentile
+    auto rank = static_cast<std::size_t>(std::ceil(p / 100 * static_cast<double>(times.size())));
+    return times[std::clamp<std::size_t>(rank, 1, times.size()) - 1];
+  }
+  [[nodiscard]] std::string distribution() const;
+
+ public:
+  CompleteWithin(Expectation<A>& expectation,
+                 std::chrono::duration<double> limit,
+                 std::function<void()> block,
+                 std::size_t runs,
+                 double percentile)
+      : MatcherBase<A, std::chrono::duration<double>>(expectation, limit),
+        block(std::move(block)),
+        runs(std::max<std::size_t>(runs, 1)),
+        percentile(percentile) {}
+
+  bool match() override;
+  std::string verb() override { return "complete within"; }
+  std::string description() override;
+  std::string failure_message() override;
+  std::string failure_message_when_negated() override;
+};
+
+template <class A>
+bool CompleteWithin<A>::match() {
+  using Clock = std::chrono::steady_clock;
+  times.clear();
+  times.reserve(runs);
+  for (std::size_t i = 0; i < runs; ++i) {
+    auto start = Clock::now();
+    block();
+    times.push_back(std::chrono::duration<double, std::nano>{Clock::now() - start}.count());
+  }
+  std::ranges::sort(times);
+  return at(percentile) <= std::chrono::duration<double, std::nano>{this->expected()}.count();
+}
+
+template <class A>
+std::string CompleteWithin<A>::description() {
+  std::string limit = format_nanoseconds(std::chrono::duration<double, std::nano>{this->expected()}.count());
+  if (runs == 1) {
+    return std::format("complete within {}", limit);
+  }
+  return std::format("complete within {} at p{} over {} runs", limit, percentile, runs);
+}
+
+template <class A>
+std::string CompleteWithin<A>::distribution() const {
+  if (times.size() == 1) {
+    return std::format("it took {}", format_nanoseconds(times.front()));
+  }
+  return std::format("it took {} (min {}, p50 {}, p90 {}, p99 {}, max {})", format_nanoseconds(at(percentile)),
+                     format_nanoseconds(times.front()), format_nanoseconds(at(50)), format_nanoseconds(at(90)),
+                     format_nanoseconds(at(99)), format_nanoseconds(times.back()));
+}
+
+template <class A>
+std::string CompleteWithin<A>::failure_message() {
+  return std::format("expected the given function ([] -> {} {{...}}) to {}, but {}", Util::demangle(typeid(A)),
+                     description(), distribution());
+}
+
+template <class A>
+std::string CompleteWithin<A>::failure_message_when_negated() {
+  return std::format("expected the given function ([] -> {} {{...}}) not to {}, but {}",
+                     Util::demangle(typeid(A)), description(), distribution());
+}
+
+}  // namespace CppSpec::Matchers
@@ -1,17 +1,91 @@
 /** @file */
 #pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
 #include "matcher_base.hpp"
 
 namespace CppSpec::Matchers {
 
+/**
+ * @brief Answers whether a container includes each of many items, from a
+ * hash set or sorted index of references into it built on first use.
+ *
+ * Elements that can be hashed are put in a hash set, which compares them
+ * with `==` just like a scan does. Otherwise, elements that are totally
+ * ordered (but not floating point, where NaN isn't) are sorted.
+ * Anything else, or items of another type than the elements, are scanned
+ * for.
+ */
+template <std::ranges::forward_range R, typename U>
+class ContainIndex {
+  using V = std::ranges::range_value_t<R>;
+  using Ref = std::reference_wrapper<const V>;
+
+  struct Hash {
+    std::size_t operator()(Ref ref) const { return std::hash<V>{}(ref.get()); }
+  };
+  struct Equal {
+    bool operator()(Ref lhs, Ref rhs) const { return lhs.get() == rhs.get(); }
+  };
+
+  // The index refers to the elements, so they have to be real objects (not, say, the bits of a vector<bool>)
+  static constexpr bool same_type =
+      std::is_same_v<std::remove_cvref_t<U>, V> && std::is_lvalue_reference_v<std::ranges::range_reference_t<const R>>;
+  static constexpr bool hashable = same_type && std::equality_comparable<V> && requires(const V& v) {
+    { std::hash<V>{}(v) } -> std::convertible_to<std::size_t>;
+  };
+  static constexpr bool sortable = same_type && std::totally_ordered<V> && !std::is_floating_point_v<V>;
+
+  static const V& get(Ref ref) { return ref.get(); }
+
+  const R& range_;
+  std::unordered_set<Ref, Hash, Equal> hashed_;
+  std::vector<Ref> sorted_;
+
+ public:
+  // Fewer items than this are scanned for rather than indexed
+  static constexpr std::size_t threshold = 16;
+
+  ContainIndex(const R& range, std::size_t items) : range_(range) {
+    if (items < threshold) {
+      return;
+    }
+    if constexpr (hashable) {
+      hashed_.reserve(std::ranges::distance(range));
+      hashed_.insert(std::ranges::begin(range), std::ranges::end(range));
+    } else if constexpr (sortable) {
+      sorted_.assign(std::ranges::begin(range), std::ranges::end(range));
+      std::ranges::sort(sorted_, std::less<>{}, &ContainIndex::get);
+    }
+  }
+
+  [[nodiscard]] bool includes(const U& item) const {
+    if constexpr (hashable) {
+      if (!hashed_.empty()) {
+        return hashed_.contains(std::cref(item));
+      }
+    } else if constexpr (sortable) {
+      if (!sorted_.empty()) {
+        return std::ranges::binary_search(sorted_, item, std::less<>{}, &ContainIndex::get);
+      }
+    }
+    return std::ranges::find(range_, item) != std::ranges::end(range_);
+  }
+};
+
 /**
  * The abstract base class for the Include matcher.
  * See template specializations below.
  */
 template <typename A, typename E, typename U>
 class ContainBase : public MatcherBase<A, E> {
-  A actual_;
-
  public:
   std::string verb() override { return "contain"; }
   std::string description() override;
@@ -20,12 +94,11 @@ class ContainBase : public MatcherBase<A, E> {
   virtual bool diffable() { return true; }
 
   ContainBase(Expectation<A>& expectation, std::initializer_list<U> expected)
-      : MatcherBase<A, std::vector<U>>(expectation, std::vector<U>(expected)), actual_(this->actual()) {};
-  ContainBase(Expectation<A>& expectation, U expected)
-      : MatcherBase<A, U>(expectation, expected), actual_(this->actual()) {};
+      : MatcherBase<A, std::vector<U>>(expectation, std::vector<U>(expected)) {};
+  ContainBase(Expectation<A>& expectation, U expected) : MatcherBase<A, U>(expectation, expected) {};
 
  protected:
-  bool actual_collection_includes(U expected_item);
+  bool actual_collection_includes(const U& expected_item);
 };
 
 template <typename A, typename E, typename U>
@@ -45,12 +118,11 @@ std::string ContainBase<A, E, U>::failure_message_when_negated() {
 }
 
 template <typename A, typename E, typename U>
-bool ContainBase<A, E, U>::actual_collection_includes(U expected_item) {
-  auto actual = this->actual();
-  auto last = *(actual.begin());
-  static_assert(Util::verbose_assert<std::is_convertible_v<U, decltype(last)>>::value,
+bool ContainBase<A, E, U>::actual_collection_includes(const U& expected_item) {
+  static_assert(Util::verbose_assert<std::is_convertible_v<U, std::ranges::range_value_t<A>>>::value,
                 "Expected item is not comparable against what is inside container.");
-  return std::ranges::find(actual, expected_item) != actual.end();
+  const auto& actual = this->actual();
+  return std::ranges::find(actual, expected_item) != std::ranges::end(actual);
 }
 
 /**
@@ -83,33 +155,32 @@ bool Contain<A, E, U>::negated_match() {
 // TODO: support std::map<E,_>
 template <typename A, typename E, typename U>
 bool Contain<A, E, U>::perform_match(Predicate predicate, Predicate /*hash_subset_predicate*/) {
-  bool retval = true;  // start off true
-  for (U expected_item : this->expected()) {
-    retval = retval && this->actual_collection_includes(expected_item);
+  static_assert(Util::verbose_assert<std::is_convertible_v<U, std::ranges::range_value_t<A>>>::value,
+                "Expected item is not comparable against what is inside container.");
+  ContainIndex<A, U> index(this->actual(), this->expected().size());
+  for (const U& expected_item : this->expected()) {
+    bool included = index.includes(expected_item);
 
     // Based on our main predicate
     switch (predicate) {
       case Predicate::all:
-        if (retval) {    // if the collection includes the item,
-          continue;      // continue the loop
-        } else {         // otherwise
-          return false;  // immediately return false
+        if (!included) {
+          return false;
         }
+        break;
       case Predicate::none:
-        if (retval) {    // if the collection includes the item
-          return false;  // immediately return false
-        } else {         // otherwise
-          continue;      // continue the loop
+        if (included) {
+          return false;
         }
+        break;
       case Predicate::any:
-        if (retval) {   // if the collection includes the item
-          return true;  // immediately return true
-        } else {        // otherwise
-          continue;     // continue the loop
+        if (included) {
+          return true;
         }
+        break;
     }
   }
-  return true;
+  return predicate != Predicate::any;
 }
 
 /**
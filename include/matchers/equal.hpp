@@ -1,6 +1,7 @@
 /** @file */
 #pragma once
 
+#include <format>
 #include <string>
 
 #include "matcher_base.hpp"
@@ -43,20 +44,14 @@ std::string Equal<A, E>::failure_message() {
 
 template <typename A, typename E>
 std::string Equal<A, E>::failure_message_when_negated() {
-  std::stringstream ss;
-  ss << "expected not " << Pretty::inspect_object(MatcherBase<A, E>::expected()) << std::endl;
-  ss << "         got " << actual_inspected() << std::endl;
-  ss << "Compared using `==`";
-  return ss.str();
+  return std::format("expected not {}\n         got {}\nCompared using `==`",
+                     Pretty::inspect_object(MatcherBase<A, E>::expected()), actual_inspected());
 }
 
 template <typename A, typename E>
 std::string Equal<A, E>::simple_failure_message() {
-  std::stringstream ss;
-  ss << "expected " << Pretty::inspect_object(MatcherBase<A, E>::expected()) << std::endl;
-  ss << "     got " << actual_inspected() << std::endl;
-  ss << "Compared using `==`";
-  return ss.str();
+  return std::format("expected {}\n     got {}\nCompared using `==`",
+                     Pretty::inspect_object(MatcherBase<A, E>::expected()), actual_inspected());
 }
 
 template <typename A, typename E>
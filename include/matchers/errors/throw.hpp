@@ -29,18 +29,18 @@ bool Throw<A, Ex>::match() {
 
 template <typename A, typename Ex>
 std::string Throw<A, Ex>::description() {
-  return std::format("throw {}", Util::demangle(typeid(Ex).name()));
+  return std::format("throw {}", Util::demangle(typeid(Ex)));
 }
 
 template <typename A, typename Ex>
 std::string Throw<A, Ex>::failure_message() {
-  return std::format("expected the given function ([] -> {} {{...}}) to {}", Util::demangle(typeid(A).name()),
+  return std::format("expected the given function ([] -> {} {{...}}) to {}", Util::demangle(typeid(A)),
                      description());
 }
 
 template <typename A, typename Ex>
 std::string Throw<A, Ex>::failure_message_when_negated() {
-  return std::format("expected the given function ([] -> {} {{...}}) not to {}", Util::demangle(typeid(A).name()),
+  return std::format("expected the given function ([] -> {} {{...}}) not to {}", Util::demangle(typeid(A)),
                      description());
 }
 }  // namespace CppSpec::Matchers
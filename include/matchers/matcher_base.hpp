@@ -10,6 +10,7 @@
 #pragma once
 
 #include <source_location>
+#include <stdexcept>
 #include <string>
 
 #include "expectations/handler.hpp"
@@ -40,8 +41,8 @@ class MatcherBase : public Pretty {
  protected:
   Expected expected_;  // The expected object contained by the matcher
 
-  // A reference to the Expectation (i.e. `expect(2)`)
-  Expectation<Actual>& expectation_;
+  // The Expectation (i.e. `expect(2)`), or nullptr once detached
+  Expectation<Actual>* expectation_;
 
  public:
   // Copy constructor
@@ -50,11 +51,11 @@ class MatcherBase : public Pretty {
   // Constructor when matcher has no 'object' to match for
   explicit MatcherBase(Expectation<Actual>& expectation)
       // We want the parent of the matcher to be the `it` block, not the Expectation.
-      : expectation_(expectation) {}
+      : expectation_(&expectation) {}
 
   // Constructor when the matcher has an object to match for. This is the most
   // commonly used constructor
-  MatcherBase(Expectation<Actual>& expectation, Expected expected) : expected_(expected), expectation_(expectation) {}
+  MatcherBase(Expectation<Actual>& expectation, Expected expected) : expected_(expected), expectation_(&expectation) {}
 
   virtual ~MatcherBase() = default;
 
@@ -66,18 +67,31 @@ class MatcherBase : public Pretty {
   virtual std::string verb() { return "match"; }
 
   // Get the 'actual' object from the Expectation
-  constexpr Actual& actual() { return expectation_.get_target(); }
+  constexpr Actual& actual() { return expectation().get_target(); }
 
   // Get the 'expected' object from the Matcher
   Expected& expected() { return expected_; }
 
   // Get the Expectation itself
-  Expectation<Actual>& expectation() { return expectation_; }
+  Expectation<Actual>& expectation() const {
+    if (expectation_ == nullptr) {
+      throw std::logic_error("A detached matcher can only describe itself from what it expects");
+    }
+    return *expectation_;
+  }
+
+  /**
+   * @brief Let go of the Expectation, so that this matcher (usually a copy)
+   * can outlive it. Only description() may be called afterwards, and only
+   * on matchers that describe themselves from expected() and their own
+   * members; anything that needs the Expectation throws std::logic_error.
+   */
+  void detach() noexcept { expectation_ = nullptr; }
 
   // Set the message to give on match failure
   virtual MatcherBase& set_message(std::string message);
 
-  [[nodiscard]] std::source_location get_location() const { return expectation_.get_location(); }
+  [[nodiscard]] std::source_location get_location() const { return expectation().get_location(); }
 
   /*--------- Primary functions -------------*/
 
@@ -152,10 +166,13 @@ std::string MatcherBase<A, E>::description() {
  */
 template <typename A, typename E>
 Result MatcherBase<A, E>::run() {
-  Result result = expectation_.positive() ? PositiveExpectationHandler::handle_matcher(*this)
-                                          : NegativeExpectationHandler::handle_matcher(*this);
+  // The handler counts what match() allocates against the example; past it,
+  // the Result and the description are the matcher's own bookkeeping
+  Result result = expectation().positive() ? PositiveExpectationHandler::handle_matcher(*this)
+                                           : NegativeExpectationHandler::handle_matcher(*this);
+  Allocations::Pause pause;
 
-  result.set_type(Util::demangle(typeid(*this).name()));
+  result.set_type(typeid(*this));  // Named only if the Result is reported
 
   // If our items didn't match, we obviously failed.
   // Only report the failure if we aren't actively ignoring it.
@@ -166,17 +183,17 @@ Result MatcherBase<A, E>::run() {
         "return a string?");
   }
 
-  if (expectation_.ignored()) {
+  if (expectation().ignored()) {
     result.set_status(Result::Status::Skipped);
   }
 
-  ItBase* parent = expectation_.get_it();
+  ItBase* parent = expectation().get_it();
   if (parent != nullptr) {
     // If we need a description for our test, generate it
     // unless we're ignoring the output.
-    if (parent->needs_description() && !expectation_.ignored()) {
+    if (parent->needs_description() && !expectation().ignored()) {
       parent->set_description(
-          (expectation_.positive() ? PositiveExpectationHandler::verb() : NegativeExpectationHandler::verb()) + " " +
+          (expectation().positive() ? PositiveExpectationHandler::verb() : NegativeExpectationHandler::verb()) + " " +
           this->description());
     }
     parent->add_result(result);
@@ -2,11 +2,22 @@
 #pragma once
 
 #include <algorithm>
-#include <regex>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <concepts>
+#include <format>
+#include <initializer_list>
+#include <ios>
+#include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "allocations.hpp"
 #include "prettyprint.hpp"
 #include "util.hpp"
 
@@ -51,8 +62,77 @@ struct Pretty {
   template <class T>
   static std::string to_sentence(const std::vector<T>& words);
 
+  template <class T>
+  static std::string to_sentence(std::initializer_list<T> items);
+
   template <typename T>
   static std::string inspect_object(const T& object);
+
+ private:
+  // The stream that values are formatted with by operator<<
+  class Stream;
+};
+
+/**
+ * @brief The types that to_word formats with std::to_chars, which print the
+ * same way as through a default-constructed stream. Character types are
+ * printed as characters by operator<<, so they're left to it.
+ */
+template <typename T>
+concept is_to_chars_formattable = std::is_floating_point_v<T> || (std::is_integral_v<T> && sizeof(T) > 1);
+
+/**
+ * @brief Lends out one output stream per thread, so that formatting a value
+ * doesn't construct (and imbue) a new one each time.
+ *
+ * A value whose operator<< pretty-prints something itself would find the
+ * stream already lent out, and gets a stream of its own.
+ */
+class Pretty::Stream {
+  static std::ostringstream& shared() {
+    thread_local std::ostringstream stream;
+    return stream;
+  }
+  static bool& lent() {
+    thread_local bool lent = false;
+    return lent;
+  }
+
+  Allocations::Pause pause_;  // The shared stream keeps its buffer, which no example should be charged for
+  std::optional<std::ostringstream> own_;
+  std::ostringstream* stream_;
+
+ public:
+  Stream() {
+    if (lent()) {
+      stream_ = &own_.emplace();
+    } else {
+      lent() = true;
+      stream_ = &shared();
+      stream_->seekp(0);
+    }
+  }
+  ~Stream() {
+    if (!own_) {
+      // Put back whatever operator<< may have changed
+      stream_->clear();
+      stream_->flags(std::ios_base::dec | std::ios_base::skipws);
+      stream_->precision(6);
+      stream_->width(0);
+      stream_->fill(' ');
+      lent() = false;
+    }
+  }
+  Stream(const Stream&) = delete;
+  Stream& operator=(const Stream&) = delete;
+
+  std::ostream& get() noexcept { return *stream_; }
+
+  /** @brief What has been written since the stream was lent out */
+  [[nodiscard]] std::string_view view() const {
+    std::streampos end = stream_->rdbuf()->pubseekoff(0, std::ios_base::cur, std::ios_base::out);
+    return stream_->view().substr(0, end < 0 ? 0 : static_cast<std::size_t>(end));
+  }
 };
 
 /**
@@ -65,34 +145,22 @@ struct Pretty {
  */
 template <typename T>
 inline std::string Pretty::to_sentence(const std::vector<T>& objects) {
-  std::vector<std::string> words;
+  std::string sentence;
+  std::size_t i = 0;
   for (const auto& object : objects) {
-    words.push_back(to_word(object));
-  }
-
-  std::stringstream ss;
-  switch (words.size()) {
-    case 0:
-      return "";
-    case 1:
-      ss << " " << words[0];
-      break;
-    case 2:
-      ss << " " << words[0] << " and " << words[1];
-      break;
-    default:
-      ss << " ";
-      for (size_t i = 0; i < words.size() - 1; ++i) {
-        if (i != 0) {
-          ss << ", ";
-        }
-        ss << words[i];
-      }
-      ss << ", and " << words.back();
-      break;
+    if (i == 0) {
+      sentence += ' ';
+    } else if (objects.size() == 2) {
+      sentence += " and ";
+    } else if (i == objects.size() - 1) {
+      sentence += ", and ";
+    } else {
+      sentence += ", ";
+    }
+    sentence += to_word(object);
+    ++i;
   }
-
-  return ss.str();
+  return sentence;
 }
 
 /**
@@ -104,15 +172,22 @@ inline std::string Pretty::to_sentence(const std::vector<T>& objects) {
  */
 template <typename T>
 inline std::string Pretty::to_sentence(const T& item) {
-  return to_sentence(std::vector{item});
+  return " " + to_word(item);
+}
+
+/**
+ * @brief Format the items of an initializer list as a sentence
+ */
+template <typename T>
+inline std::string Pretty::to_sentence(std::initializer_list<T> items) {
+  return to_sentence(std::vector<T>(items));
 }
 
 /**
  * @brief Formats an object as a string when operator<< is available
  *
- * In reality, this uses the `<<` operator, simply
- * providing a way to convert the object to a string without
- * having to deal with stringstreams.
+ * Numbers are written with std::to_chars. Everything else goes through
+ * `<<`, into a stream that is reused rather than constructed every time.
  *
  * @param item the object to be processed
  *
@@ -120,9 +195,20 @@ inline std::string Pretty::to_sentence(const T& item) {
  */
 template <Util::is_streamable T>
 inline std::string Pretty::to_word(const T& item) {
-  std::ostringstream oss;
-  oss << item;  // use operator<< to convert and append
-  return oss.str();
+  if constexpr (is_to_chars_formattable<T>) {
+    std::array<char, 64> buffer;  // Enough for any integer, or a float with 6 significant digits
+    std::to_chars_result result{};
+    if constexpr (std::is_floating_point_v<T>) {
+      result = std::to_chars(buffer.begin(), buffer.end(), item, std::chars_format::general, 6);
+    } else {
+      result = std::to_chars(buffer.begin(), buffer.end(), item);
+    }
+    return {buffer.begin(), result.ptr};
+  } else {
+    Stream stream;
+    stream.get() << item;
+    return std::string(stream.view());
+  }
 }
 
 template <>
@@ -149,10 +235,8 @@ inline std::string Pretty::to_word<std::false_type>(const std::false_type& /* it
  */
 template <typename T>
 inline std::string Pretty::to_word(const T& item) {
-  std::stringstream ss;
   // Ruby-style inspect for objects without an overloaded operator<<
-  ss << "#<" << Util::demangle(typeid(item).name()) << ":" << &item << ">";
-  return ss.str();
+  return std::format("#<{}:{}>", Util::demangle(typeid(item)), static_cast<const void*>(&item));
 }
 
 /**
@@ -179,7 +263,7 @@ template <typename T>
 inline std::string Pretty::to_word_type(const T& item) {
   std::string word = to_word(item);
   if constexpr (Util::is_streamable<T>) {
-    word += " : " + Util::demangle(typeid(T).name());
+    word += " : " + Util::demangle(typeid(T));
   }
   return word;
 }
@@ -196,31 +280,71 @@ inline std::string Pretty::name(const std::string& name) const {
 }
 
 inline std::string Pretty::split_words(const std::string& sym) {
-  return std::regex_replace(sym, std::regex("_"), " ");
+  std::string words = sym;
+  std::ranges::replace(words, '_', ' ');
+  return words;
 }
 
+/**
+ * @brief Convert a CamelCased or dashed word to snake_case
+ *
+ * Splits runs of capitals before the capital that starts the next word
+ * ("HTTPServer" -> "http_server"), and a lowercase letter or digit from a
+ * capital following it ("camelCase" -> "camel_case").
+ */
 inline std::string Pretty::underscore(const std::string& word) {
-  std::string str = std::regex_replace(word, std::regex("([A-Z]+)([A-Z][a-z])"), "$1_$2");
-  str = std::regex_replace(str, std::regex("([a-z\\d])([A-Z])"), "$1_$2");
-  str = std::regex_replace(str, std::regex("-"), "_");
-  std::ranges::transform(str, str.begin(), ::tolower);
+  auto upper = [](char c) { return c >= 'A' && c <= 'Z'; };
+  auto lower = [](char c) { return c >= 'a' && c <= 'z'; };
+  auto digit = [](char c) { return c >= '0' && c <= '9'; };
+
+  std::string str;
+  str.reserve(word.size() + word.size() / 2);
+  for (std::size_t i = 0; i < word.size(); ++i) {
+    char c = word[i];
+    if (i > 0 && upper(c)) {
+      char previous = word[i - 1];
+      bool starts_word = upper(previous) && i + 1 < word.size() && lower(word[i + 1]);
+      if (starts_word || lower(previous) || digit(previous)) {
+        str += '_';
+      }
+    }
+    str += c == '-' ? '_' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
   return str;
 }
 
 inline std::string Pretty::last(const std::string& s, const char delim) {
-  std::vector<std::string> elems;
-  std::stringstream ss(s);
-  std::string item;
-  while (getline(ss, item, delim)) {
-    if (!item.empty()) {
-      elems.push_back(item);
-    }
+  std::size_t end = s.find_last_not_of(delim);
+  if (end == std::string::npos) {
+    return "";
   }
-  return elems.back();
+  std::size_t begin = s.find_last_of(delim, end);
+  begin = begin == std::string::npos ? 0 : begin + 1;
+  return s.substr(begin, end + 1 - begin);
 }
 
+/**
+ * @brief Put spaces around the `=>` of a `key=>value` pair
+ */
 inline std::string Pretty::improve_hash_formatting(const std::string& inspect_string) {
-  return std::regex_replace(inspect_string, std::regex("(\\S)=>(\\S)"), "$1 => $2");
+  auto is_space = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+
+  std::string improved;
+  improved.reserve(inspect_string.size());
+  std::size_t i = 0;
+  while (i < inspect_string.size()) {
+    // Like a regex replacing (\S)=>(\S), pairs don't overlap
+    if (i + 3 < inspect_string.size() && !is_space(inspect_string[i]) && inspect_string.compare(i + 1, 2, "=>") == 0 &&
+        !is_space(inspect_string[i + 3])) {
+      improved += inspect_string[i];
+      improved += " => ";
+      improved += inspect_string[i + 3];
+      i += 4;
+    } else {
+      improved += inspect_string[i++];
+    }
+  }
+  return improved;
 }
 
 /**
@@ -232,7 +356,7 @@ inline std::string Pretty::improve_hash_formatting(const std::string& inspect_st
  */
 template <typename O>
 inline std::string Pretty::inspect_object(const O& o) {
-  return std::format("({}) => {}", Util::demangle(typeid(o).name()), to_word(o));
+  return std::format("({}) => {}", Util::demangle(typeid(o)), to_word(o));
 }
 
 /**
@@ -1,41 +1,32 @@
 /** @file */
 #pragma once
-#include <regex>
 #include <string>
 
 #include "matchers/matcher_base.hpp"
+#include "matchers/strings/pattern.hpp"
 
 namespace CppSpec::Matchers {
 
 template <typename A>
-class Match : public MatcherBase<A, std::regex> {
+class Match : public MatcherBase<A, Pattern> {
  public:
-  explicit Match(Expectation<A>& expectation, std::string expected)
-      : MatcherBase<A, std::regex>(expectation, std::regex(expected)) {}
-
-  explicit Match(Expectation<A>& expectation, std::regex expected)
-      : MatcherBase<A, std::regex>(expectation, expected) {}
+  explicit Match(Expectation<A>& expectation, Pattern expected)
+      : MatcherBase<A, Pattern>(expectation, std::move(expected)) {}
 
   std::string verb() override { return "match"; }
 
-  bool match() override {
-    std::smatch temp_match;
-    return std::regex_match(this->actual(), temp_match, this->expected());
-  }
+  bool match() override { return this->expected().matches(this->actual()); }
 };
 
 template <typename A>
-class MatchPartial : public MatcherBase<A, std::regex> {
+class MatchPartial : public MatcherBase<A, Pattern> {
  public:
-  explicit MatchPartial(Expectation<A>& expectation, std::string expected)
-      : MatcherBase<A, std::regex>(expectation, std::regex(expected)) {}
-
-  explicit MatchPartial(Expectation<A>& expectation, std::regex expected)
-      : MatcherBase<A, std::regex>(expectation, expected) {}
+  explicit MatchPartial(Expectation<A>& expectation, Pattern expected)
+      : MatcherBase<A, Pattern>(expectation, std::move(expected)) {}
 
   std::string description() override { return "partially match " + Pretty::to_word(this->expected()); }
 
-  bool match() override { return std::regex_match(this->actual(), this->expected()); }
+  bool match() override { return this->expected().matches(this->actual()); }
 };
 
 }  // namespace CppSpec::Matchers
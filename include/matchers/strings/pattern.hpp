@@ -0,0 +1,186 @@
+/** @file */
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "allocations.hpp"
+#include "util.hpp"
+
+namespace CppSpec::Matchers {
+
+/**
+ * @brief A regular expression that `to_match` checks the whole of a string
+ * against
+ *
+ * Patterns given as strings are compiled once per process, however many
+ * expectations use them. Those that are a plain literal, or a literal
+ * followed by `.*`, aren't compiled at all: they're compared as strings.
+ */
+class Pattern {
+ public:
+  enum class Kind {
+    Literal,  // The string has to equal the literal
+    Prefix,   // The string has to start with the literal, and `.*` match the rest
+    Regex,
+  };
+
+  /**
+   * @brief How a pattern is checked, and where in it the literal it reduces
+   * to is if it isn't a Regex (still escaped, if it was)
+   */
+  struct Shape {
+    Kind kind = Kind::Regex;
+    std::size_t begin = 0;
+    std::size_t length = 0;
+  };
+
+ private:
+  std::string source_;
+  Shape shape_;
+  std::string literal_;
+  std::shared_ptr<const std::regex> regex_;
+
+ public:
+  explicit Pattern(std::string source, std::regex::flag_type flags = std::regex::ECMAScript)
+      : source_(std::move(source)), shape_(shape_of(source_)) {
+    prepare(flags);
+  }
+
+  explicit Pattern(std::regex regex) : regex_(std::make_shared<const std::regex>(std::move(regex))) {}
+
+  /**
+   * @brief A pattern known at compile time, shaped at compile time and
+   * compiled (if it has to be) the first time it's used
+   */
+  template <Util::fixed_string Source>
+  static const Pattern& of() {
+    static constexpr Shape shape = shape_of(Source.view());
+    static const Pattern pattern{std::string(Source.view()), shape};
+    return pattern;
+  }
+
+  [[nodiscard]] const std::string& source() const noexcept { return source_; }
+  [[nodiscard]] Kind kind() const noexcept { return shape_.kind; }
+
+  /** @brief Whether the whole of `string` matches this pattern */
+  [[nodiscard]] bool matches(std::string_view string) const {
+    switch (shape_.kind) {
+      case Kind::Literal:
+        return string == literal_;
+      case Kind::Prefix:
+        // `.` matches anything but a line terminator
+        return string.starts_with(literal_) &&
+               string.find_first_of("\n\r", literal_.size()) == std::string_view::npos;
+      case Kind::Regex:
+        break;
+    }
+    return std::regex_match(string.begin(), string.end(), *regex_);
+  }
+
+  /**
+   * @brief Work out whether an ECMAScript pattern is a literal, or a
+   * literal followed by `.*`, and if so, which
+   *
+   * `^` and `$` anchors are dropped, since the whole string is matched
+   * anyway, and so are backslashes before punctuation.
+   */
+  static constexpr Shape shape_of(std::string_view source) {
+    constexpr std::string_view special = "^$\\.*+?()[]{}|";
+    Shape shape{.kind = Kind::Literal, .begin = 0, .length = source.size()};
+    if (source.starts_with('^')) {
+      shape.begin = 1;
+      shape.length -= 1;
+    }
+    std::string_view literal = source.substr(shape.begin);
+    if (literal.ends_with('$') && !escapes_last(literal)) {
+      literal.remove_suffix(1);
+    }
+    if (literal.ends_with(".*") && !escapes_last(literal.substr(0, literal.size() - 1))) {
+      shape.kind = Kind::Prefix;
+      literal.remove_suffix(2);
+    }
+    for (std::size_t i = 0; i < literal.size(); ++i) {
+      if (literal[i] == '\\') {
+        // Only escaped punctuation stands for itself; `\d` and the like don't
+        if (i + 1 == literal.size() || special.find(literal[i + 1]) == std::string_view::npos) {
+          return {};
+        }
+        ++i;
+      } else if (special.find(literal[i]) != std::string_view::npos) {
+        return {};
+      }
+    }
+    shape.length = literal.size();
+    return shape;
+  }
+
+  /** @brief Compile a pattern, or find it already compiled */
+  static std::shared_ptr<const std::regex> compile(const std::string& source, std::regex::flag_type flags) {
+    static std::mutex mutex;
+    static std::map<unsigned long, std::map<std::string, std::shared_ptr<const std::regex>, std::less<>>> compiled;
+    std::scoped_lock lock{mutex};
+    Allocations::Pause pause;  // Kept for the rest of the run, whichever example compiled it
+    auto& with_flags = compiled[static_cast<unsigned long>(flags)];
+    auto it = with_flags.find(source);
+    if (it == with_flags.end()) {
+      it = with_flags.emplace(source, std::make_shared<const std::regex>(source, flags)).first;
+    }
+    return it->second;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const Pattern& pattern) {
+    if (pattern.regex_ != nullptr && pattern.source_.empty()) {
+      return os << "#<" << Util::demangle(typeid(std::regex)) << ">";  // Built elsewhere, so there's no source
+    }
+    return os << '/' << pattern.source_ << '/';
+  }
+
+ private:
+  Pattern(std::string source, Shape shape) : source_(std::move(source)), shape_(shape) {
+    prepare(std::regex::ECMAScript);
+  }
+
+  void prepare(std::regex::flag_type flags) {
+    if (flags != std::regex::ECMAScript) {
+      shape_ = {};  // Other grammars and case-insensitivity need the real thing
+    }
+    if (shape_.kind == Kind::Regex) {
+      regex_ = compile(source_, flags);
+    } else {
+      literal_ = unescape(std::string_view(source_).substr(shape_.begin, shape_.length));
+    }
+  }
+
+  // Whether the last character of `source` is escaped by a backslash
+  static constexpr bool escapes_last(std::string_view source) {
+    if (source.empty()) {
+      return false;
+    }
+    std::size_t backslashes = 0;
+    for (std::size_t i = source.size() - 1; i > 0 && source[i - 1] == '\\'; --i) {
+      ++backslashes;
+    }
+    return backslashes % 2 == 1;
+  }
+
+  static std::string unescape(std::string_view literal) {
+    std::string unescaped;
+    unescaped.reserve(literal.size());
+    for (std::size_t i = 0; i < literal.size(); ++i) {
+      if (literal[i] == '\\') {
+        ++i;
+      }
+      unescaped += literal[i];
+    }
+    return unescaped;
+  }
+};
+
+}  // namespace CppSpec::Matchers
@@ -0,0 +1,372 @@
+/**
+ * @file
+ * @brief Running many spec binaries in parallel and merging their results,
+ * as cppspec-run does
+ */
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+extern "C" {
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+}
+
+#include "formatters/formatters_base.hpp"
+#include "formatters/junit_xml.hpp"
+#include "formatters/progress.hpp"
+#include "formatters/report.hpp"
+#include "isolation.hpp"
+
+namespace CppSpec::Orchestrator {
+
+using Formatters::ReportNodes::Example;
+using Formatters::ReportNodes::Suite;
+
+// The descriptor a spec binary writes its report to, as `--report /dev/fd/3`
+constexpr int report_fd_number = 3;
+
+/**
+ * @brief A spec binary run by the orchestrator, and what it reported.
+ */
+struct Binary {
+  std::filesystem::path path;
+  pid_t pid = -1;
+  int report_fd = -1;  // The read end of the pipe it writes its report to
+  int output_fd = -1;  // The read end of the pipe its stdout and stderr go to
+  std::string report;
+  std::string output;  // Only shown if it dies without reporting its results
+  std::vector<Suite> suites;
+
+  [[nodiscard]] std::string name() const { return path.filename().string(); }
+  [[nodiscard]] bool running() const noexcept { return report_fd >= 0 || output_fd >= 0; }
+};
+
+/**
+ * @brief Find the spec binaries in `paths`.
+ *
+ * Files are taken as they are. Directories are searched recursively for
+ * executables named like the targets `discover_specs` creates: `*_spec`.
+ *
+ * @return the binaries, in a stable order
+ * @throws std::invalid_argument if one of `paths` doesn't exist
+ */
+inline std::vector<std::filesystem::path> find_spec_binaries(const std::vector<std::filesystem::path>& paths) {
+  namespace fs = std::filesystem;
+  std::vector<fs::path> binaries;
+  for (const fs::path& path : paths) {
+    if (fs::is_regular_file(path)) {
+      binaries.push_back(path);
+      continue;
+    }
+    if (!fs::is_directory(path)) {
+      throw std::invalid_argument{"no such file or directory: " + path.string()};
+    }
+
+    std::vector<fs::path> found;
+    for (const auto& entry : fs::recursive_directory_iterator{path, fs::directory_options::skip_permission_denied}) {
+      bool executable = (entry.status().permissions() & fs::perms::owner_exec) != fs::perms::none;
+      if (entry.is_regular_file() && executable && entry.path().filename().string().ends_with("_spec")) {
+        found.push_back(entry.path());
+      }
+    }
+    std::ranges::sort(found);
+    binaries.insert(binaries.end(), found.begin(), found.end());
+  }
+  return binaries;
+}
+
+/**
+ * @brief Start a spec binary with `args`, reporting back over a pipe.
+ * @return whether it could be started
+ */
+inline bool start(Binary& binary, const std::vector<std::string>& args) {
+  int report[2];
+  int output[2];
+  if (::pipe(report) != 0) {
+    return false;
+  }
+  if (::pipe(output) != 0) {
+    ::close(report[0]);
+    ::close(report[1]);
+    return false;
+  }
+  // Keep the other binaries' pipes (and these, once moved into place) out of the child
+  for (int fd : {report[0], report[1], output[0], output[1]}) {
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+
+  std::vector<std::string> arguments{binary.path.string(), "--report", std::format("/dev/fd/{}", report_fd_number)};
+  arguments.insert(arguments.end(), args.begin(), args.end());
+  std::vector<char*> argv;
+  for (std::string& argument : arguments) {
+    argv.push_back(argument.data());
+  }
+  argv.push_back(nullptr);
+
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+
+  pid_t pid = ::fork();
+  if (pid < 0) {
+    for (int fd : {report[0], report[1], output[0], output[1]}) {
+      ::close(fd);
+    }
+    return false;
+  }
+
+  if (pid == 0) {
+    ::dup2(output[1], STDOUT_FILENO);
+    ::dup2(output[1], STDERR_FILENO);
+    ::dup2(report[1], report_fd_number);
+    ::fcntl(report_fd_number, F_SETFD, 0);  // In case the pipe was already there, with FD_CLOEXEC
+    ::execv(argv[0], argv.data());
+    ::_exit(127);
+  }
+
+  ::close(report[1]);
+  ::close(output[1]);
+  binary.pid = pid;
+  binary.report_fd = report[0];
+  binary.output_fd = output[0];
+  return true;
+}
+
+/**
+ * @brief Read whatever is waiting on one of a Binary's pipes, closing it
+ * once the binary has closed its end.
+ */
+inline void read_some(int& fd, std::string& buffer) {
+  char chunk[4096];
+  ssize_t count = ::read(fd, chunk, sizeof(chunk));
+  if (count > 0) {
+    buffer.append(chunk, static_cast<std::size_t>(count));
+  } else if (count == 0 || errno != EINTR) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+/**
+ * @brief Report a Binary that couldn't report its own results as a single
+ * example in error, along with whatever it printed.
+ */
+inline void report_error(Binary& binary, std::string message) {
+  if (!binary.output.empty()) {
+    message += "\n" + binary.output;
+  }
+  Example example{.description = "reports all of its results", .file = binary.path.string(), .line = 0};
+  example.results.push_back({.status = Result::Status::Error, .location = binary.path.string(), .message = message});
+  binary.suites.push_back(Suite{.name = binary.name(),
+                                .file = binary.path.string(),
+                                .start_time = std::chrono::system_clock::now(),
+                                .runtime = {},
+                                .examples = {std::move(example)}});
+}
+
+/**
+ * @brief Reap a Binary and read its report.
+ *
+ * A binary that dies, or exits with an error before reporting anything
+ * (e.g. because it didn't understand its arguments), is reported with
+ * report_error().
+ */
+inline void finish(Binary& binary) {
+  int status = 0;
+  while (::waitpid(binary.pid, &status, 0) < 0 && errno == EINTR) {
+  }
+
+  bool complete = Formatters::ReportNodes::read(binary.report, binary.suites);
+  bool exited = WIFEXITED(status) && (WEXITSTATUS(status) == 0 || !binary.suites.empty());
+  if (complete && exited) {
+    return;
+  }
+
+  bool not_run = WIFEXITED(status) && WEXITSTATUS(status) == 127 && binary.report.empty();  // From start()
+  report_error(binary,
+               not_run ? std::format("Could not run {}", binary.path.string()) : Isolation::describe_exit(status));
+}
+
+/**
+ * @brief Run every binary with `args`, with up to `jobs` of them at the
+ * same time, calling `on_finished` for each one as soon as it has finished.
+ */
+inline void run(std::vector<Binary>& binaries,
+                std::size_t jobs,
+                const std::vector<std::string>& args,
+                const std::function<void(const Binary&)>& on_finished) {
+  std::vector<Binary*> running;
+  auto next = binaries.begin();
+
+  while (next != binaries.end() || !running.empty()) {
+    while (running.size() < std::max<std::size_t>(jobs, 1) && next != binaries.end()) {
+      Binary& binary = *next++;
+      if (start(binary, args)) {
+        running.push_back(&binary);
+      } else {
+        report_error(binary, std::format("Could not start {}: {}", binary.path.string(), std::strerror(errno)));
+        on_finished(binary);
+      }
+    }
+    if (running.empty()) {
+      continue;
+    }
+
+    std::vector<pollfd> fds;
+    fds.reserve(running.size() * 2);
+    for (const Binary* binary : running) {
+      // poll() ignores negative descriptors, i.e. pipes that are already closed
+      fds.push_back({.fd = binary->report_fd, .events = POLLIN, .revents = 0});
+      fds.push_back({.fd = binary->output_fd, .events = POLLIN, .revents = 0});
+    }
+    if (::poll(fds.data(), fds.size(), -1) <= 0) {
+      continue;  // Interrupted, try again
+    }
+
+    // Walk backwards so that erasing a Binary doesn't move the ones still to be checked
+    for (std::size_t i = running.size(); i-- > 0;) {
+      Binary& binary = *running[i];
+      if (fds[2 * i].revents != 0) {
+        read_some(binary.report_fd, binary.report);
+      }
+      if (fds[2 * i + 1].revents != 0) {
+        read_some(binary.output_fd, binary.output);
+      }
+      if (!binary.running()) {
+        finish(binary);
+        on_finished(binary);
+        running.erase(running.begin() + static_cast<std::ptrdiff_t>(i));
+      }
+    }
+  }
+}
+
+/**
+ * @brief One progress display for every binary: a character per example,
+ * printed as each binary finishes, followed by the failures of them all.
+ */
+class ProgressDisplay : public Formatters::BaseFormatter {
+  std::list<std::string> failures;
+  std::size_t examples = 0;
+  std::size_t failed = 0;
+  std::size_t errored = 0;
+
+ public:
+  explicit ProgressDisplay(std::ostream& out_stream = std::cout, bool color = is_terminal())
+      : BaseFormatter(out_stream, color) {}
+
+  void format(const Binary& binary);
+  void summarize(std::size_t binaries, std::chrono::duration<double> wall_time);
+};
+
+inline void ProgressDisplay::format(const Binary& binary) {
+  for (const Suite& suite : binary.suites) {
+    for (const Example& example : suite.examples) {
+      Result::Status status = example.status();
+      out_stream << status_color(status) << Formatters::Progress::status_char(status) << reset_color();
+      examples++;
+      if (status != Result::Status::Failure && status != Result::Status::Error) {
+        continue;
+      }
+      (status == Result::Status::Failure ? failed : errored)++;
+
+      std::string message = std::format("{}{}) {} {}{}\n", set_color(RED), failed + errored, binary.name(),
+                                        example.description, reset_color());
+      for (const auto& result : example.results) {
+        if (result.status == Result::Status::Failure || result.status == Result::Status::Error) {
+          message += std::format("{}{}\n{}{}\n", set_color(RED), result.location, result.message, reset_color());
+        }
+      }
+      failures.push_back(std::move(message));
+    }
+  }
+  out_stream << std::flush;
+}
+
+inline void ProgressDisplay::summarize(std::size_t binaries, std::chrono::duration<double> wall_time) {
+  out_stream << std::endl;
+  for (const std::string& failure : failures) {
+    out_stream << std::endl << failure;
+  }
+  bool success = failed == 0 && errored == 0;
+  out_stream << std::endl
+             << status_color(success ? Result::Status::Success : Result::Status::Failure)
+             << std::format("{} examples, {} failures, {} errors in {} spec binaries ({:.2f}s)", examples, failed,
+                            errored, binaries, wall_time.count())
+             << reset_color() << std::endl;
+}
+
+/**
+ * @brief Merge the reports of every binary into one set of JUnit test suites.
+ *
+ * Test cases are named as in a single binary's JUnit output, with the name
+ * of the binary as their class name to tell them apart.
+ */
+inline Formatters::JUnitNodes::TestSuites to_junit(const std::vector<Binary>& binaries, std::string name) {
+  namespace JUnit = Formatters::JUnitNodes;
+  JUnit::TestSuites suites{.name = std::move(name)};
+  for (const Binary& binary : binaries) {
+    for (const Suite& suite : binary.suites) {
+      auto failures =
+          static_cast<std::size_t>(std::ranges::count(suite.examples, Result::Status::Failure, &Example::status));
+      JUnit::TestSuite& test_suite = suites.suites.emplace_back(suite.name, suite.runtime, suite.examples.size(),
+                                                                 failures, suite.start_time);
+      for (const Example& example : suite.examples) {
+        JUnit::TestCase test_case{
+            .name = example.description,
+            .classname = binary.name(),
+            .assertions = example.successes + example.results.size(),
+            .time = example.runtime,
+            .results = {},
+            .file = example.file,
+            .line = example.line,
+        };
+        for (const auto& result : example.results) {
+          if (result.status == Result::Status::Failure || result.status == Result::Status::Error) {
+            auto status = result.status == Result::Status::Error ? JUnit::Result::Status::Error
+                                                                 : JUnit::Result::Status::Failure;
+            test_case.results.emplace_back(result.location + ": Match failure.", result.type, result.message, status);
+          }
+        }
+        test_suite.cases.push_back(std::move(test_case));
+      }
+      suites.tests += test_suite.tests;
+      suites.failures += test_suite.failures;
+      suites.time += test_suite.time;
+    }
+  }
+  if (!suites.suites.empty()) {
+    suites.timestamp = std::ranges::min(suites.suites, {}, &JUnit::TestSuite::timestamp).timestamp;
+  }
+  return suites;
+}
+
+/**
+ * @brief Whether every example of every binary passed (or was skipped).
+ */
+inline bool succeeded(const std::vector<Binary>& binaries) {
+  return std::ranges::all_of(binaries, [](const Binary& binary) {
+    return std::ranges::all_of(binary.suites, [](const Suite& suite) {
+      return std::ranges::none_of(suite.examples, [](const Example& example) {
+        return example.status() == Result::Status::Failure || example.status() == Result::Status::Error;
+      });
+    });
+  });
+}
+
+}  // namespace CppSpec::Orchestrator
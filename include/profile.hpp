@@ -0,0 +1,149 @@
+/**
+ * @file
+ * @brief Reporting where the time of a run went
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <list>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "description.hpp"
+#include "it_base.hpp"
+
+namespace CppSpec {
+
+/**
+ * @brief The slowest examples and Descriptions of a run, each with its share
+ * of the run's wall time.
+ *
+ * Built from the runtimes recorded while running, after the run, so it works
+ * the same whichever formatters are in use. A Description's time is split
+ * between its children and its own time: everything else it spent, mostly in
+ * `before_all` and `after_all` hooks (per-example hooks and `let` blocks count
+ * towards the example they run for). When children run concurrently (with
+ * `--jobs`) they can add up to more than their parent, in which case its own
+ * time is counted as zero.
+ */
+class Profile {
+ public:
+  using Seconds = std::chrono::duration<double>;
+
+  struct Entry {
+    const Runnable* runnable;
+    std::string description;
+    Seconds total;
+    Seconds own;  // Time not spent in children; the same as `total` for an example
+  };
+
+ private:
+  std::vector<Entry> examples_;
+  std::vector<Entry> groups_;
+  Seconds wall_time_;
+
+  void add(const Runnable& runnable, const std::string& parent_description);
+  static std::vector<Entry> slowest(std::vector<Entry> entries, std::size_t count);
+
+ public:
+  Profile(const std::list<Description*>& specs, Seconds wall_time);
+
+  [[nodiscard]] std::vector<Entry> slowest_examples(std::size_t count) const { return slowest(examples_, count); }
+  [[nodiscard]] std::vector<Entry> slowest_groups(std::size_t count) const { return slowest(groups_, count); }
+  [[nodiscard]] Seconds get_wall_time() const noexcept { return wall_time_; }
+
+  void print(std::ostream& out, std::size_t count) const;
+};
+
+inline Profile::Profile(const std::list<Description*>& specs, Seconds wall_time) : wall_time_(wall_time) {
+  for (const Description* spec : specs) {
+    add(*spec, "");
+  }
+}
+
+/**
+ * @brief Record the runtime of a selected Runnable, and of everything in it.
+ *
+ * Entries are described starting from their top-level describe, so that
+ * those of different specs can be told apart.
+ */
+inline void Profile::add(const Runnable& runnable, const std::string& parent_description) {
+  if (!runnable.is_selected()) {
+    return;
+  }
+  std::string full_description = parent_description;
+  if (const auto* it = dynamic_cast<const ItBase*>(&runnable)) {
+    full_description += (full_description.empty() ? "" : " ") + it->get_description();
+    examples_.push_back({it, std::move(full_description), it->get_runtime(), it->get_runtime()});
+    return;
+  }
+  const auto* description = dynamic_cast<const Description*>(&runnable);
+  if (description == nullptr) {
+    return;
+  }
+  full_description += (full_description.empty() ? "" : " ") + description->get_description();
+
+  Seconds children{};
+  for (const auto& child : runnable.get_children()) {
+    if (child->is_selected()) {
+      children += child->get_runtime();
+      add(*child, full_description);
+    }
+  }
+  Seconds own = std::max(runnable.get_runtime() - children, Seconds{});
+  groups_.push_back({description, std::move(full_description), runnable.get_runtime(), own});
+}
+
+/**
+ * @brief The `count` entries that took longest, slowest first. Ties keep the
+ * order the entries were defined in.
+ */
+inline std::vector<Profile::Entry> Profile::slowest(std::vector<Entry> entries, std::size_t count) {
+  std::ranges::stable_sort(entries, std::ranges::greater{}, &Entry::total);
+  if (entries.size() > count) {
+    entries.resize(count);
+  }
+  return entries;
+}
+
+/**
+ * @brief Print the `count` slowest examples and Descriptions.
+ */
+inline void Profile::print(std::ostream& out, std::size_t count) const {
+  auto share = [this](Seconds time) { return wall_time_.count() > 0 ? 100 * time / wall_time_ : 0.0; };
+  auto location = [](const Entry& entry) {
+    return std::format("{}:{}", entry.runnable->get_location().file_name(), entry.runnable->get_location().line());
+  };
+
+  std::vector<Entry> examples = slowest_examples(count);
+  Seconds examples_total{};
+  for (const Entry& entry : examples) {
+    examples_total += entry.total;
+  }
+  out << std::endl
+      << std::format("Slowest {} example(s) ({:.3f}s, {:.1f}% of {:.3f}s):", examples.size(), examples_total.count(),
+                     share(examples_total), wall_time_.count())
+      << std::endl;
+  for (const Entry& entry : examples) {
+    out << std::format("  {:>8.3f}s {:>5.1f}%  {} ({})", entry.total.count(), share(entry.total), entry.description,
+                       location(entry))
+        << std::endl;
+  }
+
+  std::vector<Entry> groups = slowest_groups(count);
+  out << std::endl << std::format("Slowest {} describe(s):", groups.size()) << std::endl;
+  for (const Entry& entry : groups) {
+    out << std::format("  {:>8.3f}s {:>5.1f}%  {} ({})", entry.total.count(), share(entry.total), entry.description,
+                       location(entry))
+        << std::endl
+        << std::format("             own {:.3f}s, children {:.3f}s", entry.own.count(),
+                       (entry.total - entry.own).count())
+        << std::endl;
+  }
+}
+
+}  // namespace CppSpec
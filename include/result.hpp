@@ -6,8 +6,11 @@
 #include <source_location>
 #include <sstream>
 #include <string>
+#include <typeinfo>
 #include <utility>
 
+#include "util.hpp"
+
 namespace CppSpec {
 
 class Result {
@@ -40,8 +43,21 @@ class Result {
     return std::format("{}:{}:{}", location.file_name(), location.line(), location.column());
   }
 
-  [[nodiscard]] std::string get_type() const noexcept { return type; }
-  void set_type(std::string type) noexcept { this->type = std::move(type); }
+  /**
+   * @brief The name of the matcher that produced this Result. A Result made
+   * by a matcher only holds its std::type_info and names it when asked.
+   */
+  [[nodiscard]] std::string get_type() const {
+    return type_info_ != nullptr ? Util::demangle(*type_info_) : type;
+  }
+  void set_type(std::string type) noexcept {
+    this->type = std::move(type);
+    type_info_ = nullptr;
+  }
+  void set_type(const std::type_info& type) noexcept {
+    this->type.clear();
+    type_info_ = &type;
+  }
 
   /*--------- Message helper functions -------------*/
   [[nodiscard]] std::string get_message() const noexcept { return message; }
@@ -102,6 +118,7 @@ class Result {
   std::source_location location;
   std::string message;
   std::string type;
+  const std::type_info* type_info_ = nullptr;
   Result(Status status, std::source_location location, std::string message = "") noexcept
       : status_(status), location(location), message(std::move(message)) {}
 };
@@ -0,0 +1,204 @@
+/**
+ * @file
+ * @brief Replaying the results of a spec binary that hasn't changed
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "description.hpp"
+#include "serialization.hpp"
+#include "util.hpp"
+
+namespace CppSpec {
+
+// Examples paired with their IDs, as given by Runner::example_id
+using ExampleIds = std::vector<std::pair<ItBase*, std::string>>;
+
+/**
+ * @brief The results of the examples of one spec binary, kept from one
+ * passing run to the next.
+ *
+ * The cache is only valid for the binary it was written by, which is
+ * identified by a hash of its contents. If every example a run selects has
+ * a cached result for that binary, the Runner replays them through the
+ * formatters rather than running anything. Only runs in which every example
+ * passed are cached, so anything that failed is always run again.
+ */
+class ResultCache {
+  struct CachedResult {
+    Result::Status status = Result::Status::Success;
+    std::string message;
+    std::string type;
+  };
+
+  struct Entry {
+    std::string description;  // Generated while running if the example wasn't given one
+    double runtime = 0;
+    std::uint64_t successes = 0;
+    std::vector<CachedResult> results;  // Other than successes
+  };
+
+  static constexpr std::string_view magic = "cppspec-results-2";
+
+  std::string path_;
+  std::uint64_t build_id_;
+  std::unordered_map<std::string, Entry> entries_;
+
+  void load();
+
+ public:
+  ResultCache(std::string path, std::uint64_t build_id) : path_(std::move(path)), build_id_(build_id) { load(); }
+
+  static std::optional<std::uint64_t> build_id(const std::filesystem::path& executable);
+
+  bool replay(const ExampleIds& examples) const;
+  void store(const ExampleIds& examples);
+};
+
+/**
+ * @brief Identify a build of a spec binary by hashing its contents.
+ * @return the hash, or nothing if the binary can't be read
+ */
+inline std::optional<std::uint64_t> ResultCache::build_id(const std::filesystem::path& executable) {
+  std::ifstream file{executable, std::ios::binary};
+  if (!file) {
+    return std::nullopt;
+  }
+  std::uint64_t hash = Util::stable_hash("");
+  char chunk[1 << 16];
+  while (file.read(chunk, sizeof(chunk)) || file.gcount() > 0) {
+    hash = Util::stable_hash(std::string_view{chunk, static_cast<std::size_t>(file.gcount())}, hash);
+  }
+  return hash;
+}
+
+/**
+ * @brief Read the cache file, unless it's missing, unreadable, or was
+ * written by a different build.
+ */
+inline void ResultCache::load() {
+  std::ifstream file{path_, std::ios::binary};
+  std::string data{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+  Serialization::Reader in{data};
+
+  std::string header;
+  std::uint64_t build_id = 0;
+  std::uint64_t count = 0;
+  if (!in.read_string(header) || header != magic || !in.read(build_id) || build_id != build_id_ || !in.read(count)) {
+    return;
+  }
+
+  std::unordered_map<std::string, Entry> entries;
+  for (std::uint64_t i = 0; i < count; ++i) {
+    std::string id;
+    Entry entry;
+    std::uint64_t results = 0;
+    if (!in.read_string(id) || !in.read_string(entry.description) || !in.read(entry.runtime) ||
+        !in.read(entry.successes) || !in.read(results)) {
+      return;
+    }
+    for (std::uint64_t j = 0; j < results; ++j) {
+      CachedResult& result = entry.results.emplace_back();
+      if (!in.read(result.status) || !in.read_string(result.message) || !in.read_string(result.type)) {
+        return;
+      }
+    }
+    entries.emplace(std::move(id), std::move(entry));
+  }
+  entries_ = std::move(entries);
+}
+
+/**
+ * @brief Fill in the results of `examples` from the cache.
+ *
+ * Results take the location of their example, since those of individual
+ * expectations don't survive from one process to the next. The Descriptions
+ * containing the examples are timed as the sum of what they contain.
+ *
+ * @return false, changing nothing, unless every one of `examples` is cached
+ */
+inline bool ResultCache::replay(const ExampleIds& examples) const {
+  for (const auto& [it, id] : examples) {
+    if (!entries_.contains(id)) {
+      return false;
+    }
+  }
+
+  auto now = std::chrono::system_clock::now();
+  for (const auto& [it, id] : examples) {
+    const Entry& entry = entries_.at(id);
+    it->set_description(entry.description);
+    it->set_start_time(now);
+    it->set_runtime(std::chrono::duration<double>{entry.runtime});
+    it->clear_results();
+    it->add_successes(entry.successes);
+    for (const CachedResult& cached : entry.results) {
+      Result result = Result::success(it->get_location());
+      result.set_status(cached.status);
+      result.set_message(cached.message);
+      result.set_type(cached.type);
+      it->add_result(result);
+    }
+
+    for (Runnable* parent = it->get_parent(); parent != nullptr; parent = parent->get_parent()) {
+      parent->set_start_time(now);
+      parent->set_runtime(parent->get_runtime() + it->get_runtime());
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Add the results of the `examples` that ran to the cache, and save it.
+ */
+inline void ResultCache::store(const ExampleIds& examples) {
+  for (const auto& [it, id] : examples) {
+    if (!it->is_selected()) {
+      continue;
+    }
+    Entry entry{.description = it->get_description(),
+                .runtime = it->get_runtime().count(),
+                .successes = it->get_success_count(),
+                .results = {}};
+    for (const Result& result : it->get_results()) {
+      entry.results.push_back({result.status(), result.get_message(), result.get_type()});
+    }
+    entries_.insert_or_assign(id, std::move(entry));
+  }
+
+  Serialization::Writer out;
+  out.write_string(magic);
+  out.write(build_id_);
+  out.write(std::uint64_t{entries_.size()});
+  for (const auto& [id, entry] : entries_) {
+    out.write_string(id);
+    out.write_string(entry.description);
+    out.write(entry.runtime);
+    out.write(entry.successes);
+    out.write(std::uint64_t{entry.results.size()});
+    for (const CachedResult& result : entry.results) {
+      out.write(result.status);
+      out.write_string(result.message);
+      out.write_string(result.type);
+    }
+  }
+
+  std::ofstream file{path_, std::ios::binary | std::ios::trunc};
+  file << out.str();
+  if (!file) {
+    std::cerr << "Could not write the result cache to " << path_ << std::endl;
+  }
+}
+
+}  // namespace CppSpec
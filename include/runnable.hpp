@@ -1,9 +1,15 @@
 #pragma once
 
 #include <chrono>
-#include <list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <random>
 #include <source_location>
 #include <string>
+#include <utility>
+#include <vector>
 #include "result.hpp"
 
 namespace CppSpec {
@@ -40,15 +46,37 @@ class Runnable {
   // The source file location of the Runnable object
   std::source_location location;
 
-  std::list<std::shared_ptr<Runnable>> children_;  // List of children
+  // The children of this object, which it owns. They are constructed in the
+  // arena of the root of the tree, so that building a large tree doesn't take
+  // an allocation per node, and destroying it frees the nodes all at once.
+  std::vector<Runnable*> children_;
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_;  // Only ever set on the root
+
+  std::pmr::memory_resource& arena() {
+    Runnable* root = this;
+    while (root->parent != nullptr) {
+      root = root->parent;
+    }
+    if (!root->arena_) {
+      root->arena_ = std::make_unique<std::pmr::monotonic_buffer_resource>();
+    }
+    return *root->arena_;
+  }
 
   std::chrono::time_point<std::chrono::system_clock> start_time_;
   std::chrono::duration<double> runtime_{};
 
+  // Whether this object takes part in the run (e.g. it belongs to this shard)
+  bool selected_ = true;
+
  public:
   Runnable(std::source_location location) : location(location) {}
 
-  virtual ~Runnable() = default;
+  virtual ~Runnable() {
+    for (Runnable* child : children_) {
+      child->~Runnable();  // Its memory is released with the arena
+    }
+  }
 
   /*--------- Parent helper functions -------------*/
 
@@ -61,8 +89,8 @@ class Runnable {
   [[nodiscard]] Runnable* get_parent() noexcept { return parent; }
   [[nodiscard]] const Runnable* get_parent() const noexcept { return parent; }
 
-  std::list<std::shared_ptr<Runnable>>& get_children() noexcept { return children_; }
-  [[nodiscard]] const std::list<std::shared_ptr<Runnable>>& get_children() const noexcept { return children_; }
+  std::vector<Runnable*>& get_children() noexcept { return children_; }
+  [[nodiscard]] const std::vector<Runnable*>& get_children() const noexcept { return children_; }
 
   template <class C>
   C* get_parent_as() noexcept {
@@ -76,11 +104,25 @@ class Runnable {
 
   template <typename T, typename... Args>
   T* make_child(Args&&... args) {
-    auto child = std::make_shared<T>(std::forward<Args>(args)...);
-    auto* child_ptr = child.get();
+    T* child = new (arena().allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
     child->parent = this;
-    children_.push_back(std::move(child));
-    return child_ptr;
+    children_.push_back(child);
+    return child;
+  }
+
+  /**
+   * @brief Randomly reorder the children of this Runnable, and theirs.
+   *
+   * Uses a Fisher-Yates shuffle on the raw output of `rng` (rather than
+   * std::shuffle) so that the same seed gives the same order everywhere.
+   */
+  void shuffle_children(std::mt19937_64& rng) {
+    for (std::size_t i = children_.size(); i > 1; --i) {
+      std::swap(children_[i - 1], children_[rng() % i]);
+    }
+    for (auto* child : children_) {
+      child->shuffle_children(rng);
+    }
   }
 
   /*--------- Primary member functions -------------*/
@@ -94,6 +136,10 @@ class Runnable {
   // Set the location of the object
   void set_location(std::source_location location) noexcept { this->location = location; }
 
+  /** @brief Whether this Runnable will be run and reported. */
+  [[nodiscard]] bool is_selected() const noexcept { return selected_; }
+  void set_selected(bool selected) noexcept { selected_ = selected; }
+
   virtual void run() = 0;
 
   virtual void timed_run() {
@@ -105,8 +151,12 @@ class Runnable {
   }
 
   [[nodiscard]] std::chrono::duration<double> get_runtime() const { return runtime_; }
+  void set_runtime(std::chrono::duration<double> runtime) noexcept { runtime_ = runtime; }
 
   [[nodiscard]] std::chrono::time_point<std::chrono::system_clock> get_start_time() const { return start_time_; }
+  void set_start_time(std::chrono::time_point<std::chrono::system_clock> start_time) noexcept {
+    start_time_ = start_time;
+  }
 
   [[nodiscard]] virtual Result get_result() const {
     Result result = Result::success(location);
@@ -117,6 +167,9 @@ class Runnable {
   }
 
   [[nodiscard]] size_t num_tests() const noexcept {
+    if (!is_selected()) {
+      return 0;
+    }
     if (get_children().empty()) {
       return 1;  // This is a leaf node
     }
@@ -130,6 +183,9 @@ class Runnable {
   }
 
   [[nodiscard]] size_t num_failures() const noexcept {
+    if (!is_selected()) {
+      return 0;
+    }
     if (get_children().empty()) {
       return this->get_result().is_failure() ? 1 : 0;  // This is a leaf node
     }
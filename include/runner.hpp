@@ -1,21 +1,187 @@
 /** @file */
 #pragma once
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <forward_list>
+#include <fstream>
+#include <functional>
+#include <iostream>
 #include <list>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <regex>
+#include <set>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
+
+#ifndef CPPSPEC_SEMIHOSTED
+#include <mutex>
+#include <thread>
+
+#include "scheduler.hpp"
+#include "watchdog.hpp"
+#endif
+
+#if !defined(CPPSPEC_SEMIHOSTED) && !defined(_WIN32)
+#include "isolation.hpp"
+#endif
 
 #include "description.hpp"
 #include "formatters/formatters_base.hpp"
+#include "profile.hpp"
 #include "result.hpp"
+#include "result_cache.hpp"
 
 namespace CppSpec {
 
 /**
- * @brief A collection of Descriptions that are run in sequence
+ * @brief Copies of the parts of a run that have finished, which can be
+ * reported while the rest of it is still running
+ */
+namespace Snapshot {
+
+using Finished = std::unordered_set<const ItBase*>;
+
+// A Description as it was declared, without its hooks or examples
+class Described : public Description {
+  std::string subject_type_;
+
+ public:
+  explicit Described(const Description& original)
+      : Description(original.get_location(), original.get_description()),
+        subject_type_(original.get_subject_type()) {}
+  [[nodiscard]] std::string get_subject_type() const noexcept override { return subject_type_; }
+};
+
+// An example's description, timings and results, without its body
+class Example : public ItBase {
+ public:
+  Example(std::source_location location, std::string_view description) : ItBase(location) {
+    set_description(description);
+  }
+  void run() override {}
+};
+
+// The example the run is being given up on, as it was when it started
+struct Hung {
+  const ItBase* example;
+  std::string name;
+  RunControl::Seconds timeout;
+};
+
+/**
+ * @brief Copy the examples beneath `original` that are in `finished` into
+ * `copy`, along with `hung` as having timed out. Descriptions without any
+ * such examples are deselected, so they aren't reported.
+ *
+ * Only the tree's structure, which doesn't change while it runs, and the
+ * finished examples are read.
+ *
+ * @return whether any example was copied
+ */
+inline bool copy_finished(const Description& original, Description& copy, const Finished& finished, const Hung& hung) {
+  // A Description ran from when the first of its examples started, for as long as they all took
+  auto account = [&copy](const Runnable& child) {
+    bool first = copy.get_start_time() == std::chrono::system_clock::time_point{};
+    copy.set_start_time(first ? child.get_start_time() : std::min(copy.get_start_time(), child.get_start_time()));
+    copy.set_runtime(copy.get_runtime() + child.get_runtime());
+  };
+
+  bool copied = false;
+  for (const Runnable* child : original.get_children()) {
+    if (const auto* description = dynamic_cast<const Description*>(child)) {
+      auto* described = copy.make_child<Described>(*description);
+      described->set_selected(copy_finished(*description, *described, finished, hung));
+      if (described->is_selected()) {
+        account(*described);
+        copied = true;
+      }
+      continue;
+    }
+
+    const auto* it = dynamic_cast<const ItBase*>(child);
+    if (it == nullptr || (it != hung.example && !finished.contains(it))) {
+      continue;  // Never started, or still running
+    }
+    Example* example = nullptr;
+    if (finished.contains(it)) {
+      example = copy.make_child<Example>(it->get_location(), it->get_description());
+      example->set_start_time(it->get_start_time());
+      example->set_runtime(it->get_runtime());
+      example->add_successes(it->get_success_count());
+      for (const Result& result : it->get_results()) {
+        example->add_result(result);
+      }
+      if (const auto& stats = it->get_benchmark_stats()) {
+        example->set_benchmark_stats(*stats);
+      }
+      if (const auto& allocations = it->get_allocations()) {
+        example->set_allocations(*allocations);
+      }
+    } else {
+      example = copy.make_child<Example>(it->get_location(), hung.name);
+      // It was given up on once it had run for twice its timeout
+      auto running = std::chrono::duration_cast<std::chrono::system_clock::duration>(hung.timeout * 2);
+      example->set_start_time(std::chrono::system_clock::now() - running);
+      example->set_runtime(hung.timeout);
+      example->add_result(
+          Result::error_with(it->get_location(), std::format("Timed out after {}s", hung.timeout.count())));
+    }
+    account(*example);
+    copied = true;
+  }
+  return copied;
+}
+
+}  // namespace Snapshot
+
+/**
+ * @brief A collection of Descriptions that are run in sequence, or
+ * concurrently when given more than one job
  */
 class Runner {
   std::list<Description*> specs;
   std::list<std::shared_ptr<Formatters::BaseFormatter>> formatters;
+  std::size_t jobs = 1;
+  std::size_t shard_index = 0;
+  std::size_t shard_count = 1;
+  bool shard_by_timings = false;
+  std::string timings_file;  // Where the runtime of every example is kept, if anywhere
+  bool isolated = false;
+  std::size_t max_failures = 0;
+  std::optional<RunControl::Seconds> timeout;
+  bool fail_on_leaks = false;
+  std::optional<std::uint64_t> seed;  // Set when running in random order
+  std::vector<Description::Predicate> filters;  // An example runs if it matches any of these
+  std::string failures_file;                    // Where failed examples are recorded, if anywhere
+  bool only_failures = false;
+  std::string result_cache;  // Where the results of passing runs are cached, if anywhere
+  std::uint64_t build_id = 0;
+  std::size_t profile_count = 0;  // How many of the slowest examples and describes to report
+  std::ostream* profile_stream = &std::cout;
+
+  void select_examples();
+  [[nodiscard]] ExampleIds selected_example_ids() const;
+  void record_failures(const ExampleIds& examples) const;
+  void record_timings(const ExampleIds& examples) const;
+  void select_shard();
+  void shuffle();
+  void execute(RunControl& control);
+  void format_results();
+  void report_hung(const Snapshot::Hung& hung, const Snapshot::Finished& finished);
+  static bool has_timeouts(const Runnable& runnable);
 
  public:
   template <typename... Formatters>
@@ -41,16 +207,351 @@ class Runner {
     return *this;
   }
 
+  /**
+   * @brief Set how many specs may run at the same time
+   *
+   * @param jobs the number of worker threads, or 0 for one per hardware thread
+   * @return a reference to the modified Runner
+   */
+  Runner& set_jobs(std::size_t jobs) {
+#ifndef CPPSPEC_SEMIHOSTED
+    this->jobs = jobs == 0 ? std::max(1U, std::thread::hardware_concurrency()) : jobs;
+#endif
+    return *this;
+  }
+  [[nodiscard]] std::size_t get_jobs() const noexcept { return jobs; }
+
+  /**
+   * @brief Run each spec in a process of its own
+   *
+   * Up to `jobs` processes run at the same time. A spec that crashes is
+   * reported as an error rather than taking down the whole run. Only
+   * available on POSIX systems; elsewhere specs keep running in-process.
+   *
+   * @param isolated whether to fork a process for every spec
+   * @return a reference to the modified Runner
+   */
+  Runner& set_isolated(bool isolated) {
+#if !defined(CPPSPEC_SEMIHOSTED) && !defined(_WIN32)
+    this->isolated = isolated;
+#endif
+    return *this;
+  }
+  [[nodiscard]] bool is_isolated() const noexcept { return isolated; }
+
+  /**
+   * @brief Run specs, and the examples and contexts within them, in an order
+   * shuffled using `seed`
+   *
+   * The same seed always gives the same order, so a run that fails because
+   * of the order its examples ran in can be replayed.
+   *
+   * @param seed the seed for the shuffle
+   * @return a reference to the modified Runner
+   */
+  Runner& set_random_order(std::uint64_t seed) noexcept {
+    this->seed = seed;
+    return *this;
+  }
+
+  /**
+   * @brief Run everything in the order it was declared (the default)
+   * @return a reference to the modified Runner
+   */
+  Runner& set_defined_order() noexcept {
+    seed.reset();
+    return *this;
+  }
+  [[nodiscard]] std::optional<std::uint64_t> get_seed() const noexcept { return seed; }
+
+  /**
+   * @brief Give every example that doesn't have a timeout of its own (or
+   * from its Descriptions) a time limit
+   *
+   * An example that runs for longer is reported as an error. If it is still
+   * running long after its timeout, what has finished is reported and the
+   * run is given up on; with `set_isolated`, its process is killed instead.
+   *
+   * @param timeout the time limit of each example
+   * @return a reference to the modified Runner
+   */
+  Runner& set_timeout(RunControl::Seconds timeout) noexcept {
+    this->timeout = timeout;
+    return *this;
+  }
+  [[nodiscard]] std::optional<RunControl::Seconds> get_timeout() const noexcept { return timeout; }
+
+  /**
+   * @brief Stop starting new examples once `max_failures` have failed
+   *
+   * Examples that were never started aren't reported, but everything
+   * that did run is still passed on to the formatters.
+   *
+   * @param max_failures how many failed (or errored) examples to allow, or 0 to never stop
+   * @return a reference to the modified Runner
+   */
+  Runner& set_fail_fast(std::size_t max_failures) noexcept {
+    this->max_failures = max_failures;
+    return *this;
+  }
+  [[nodiscard]] std::size_t get_fail_fast() const noexcept { return max_failures; }
+
+  /**
+   * @brief Fail examples that don't free everything they allocate
+   *
+   * Only meaningful when allocations are tracked (see allocations.hpp).
+   * Otherwise such examples are only flagged, in the output of the
+   * formatters that show allocations, as memory kept on purpose (e.g. in
+   * function-local statics or caches) looks just like a leak.
+   *
+   * @param fail whether leaking fails an example
+   * @return a reference to the modified Runner
+   */
+  Runner& set_fail_on_leaks(bool fail) noexcept {
+    fail_on_leaks = fail;
+    return *this;
+  }
+
+  /**
+   * @brief Only run the examples that belong to one of `count` shards
+   *
+   * Every example is assigned to a shard by a stable hash of its full
+   * description and source location (or by runtime, see
+   * `set_shard_by_timings`), so running the same binary with each index
+   * from 0 to count - 1 runs every example exactly once.
+   *
+   * @param index the shard to run, less than `count`
+   * @param count the total number of shards
+   * @return a reference to the modified Runner
+   */
+  Runner& set_shard(std::size_t index, std::size_t count) {
+    if (count == 0 || index >= count) {
+      throw std::out_of_range{std::format("shard index {} is out of range for {} shard(s)", index, count)};
+    }
+    shard_index = index;
+    shard_count = count;
+    return *this;
+  }
+
+  static std::size_t shard_of(const ItBase& it, std::size_t count);
+
+  /**
+   * @brief Keep the runtime of every example that runs in `path`
+   *
+   * After every run, the runtimes of the examples that ran replace those
+   * already in the file. A sharded run leaves the file as it is, so that
+   * every shard reads the same runtimes; it writes the runtimes of its own
+   * examples to `path.shard-INDEX` instead. As later lines of a timings file
+   * override earlier ones, `cat path path.shard-*` merges them. See
+   * `set_shard_by_timings`.
+   *
+   * @param path the file to keep runtimes in
+   * @return a reference to the modified Runner
+   */
+  Runner& set_timings_file(std::string path) {
+    timings_file = std::move(path);
+    return *this;
+  }
+  [[nodiscard]] const std::string& get_timings_file() const noexcept { return timings_file; }
+
+  /**
+   * @brief Split examples into shards of about the same total runtime,
+   * going by the timings file, instead of by hash
+   *
+   * Every shard must read the same timings file, so that they all agree on
+   * which example goes where. Examples missing from it are assumed to take
+   * as long as the average example that isn't.
+   *
+   * @param by_timings whether to balance shards by runtime
+   * @return a reference to the modified Runner
+   */
+  Runner& set_shard_by_timings(bool by_timings) noexcept {
+    shard_by_timings = by_timings;
+    return *this;
+  }
+  [[nodiscard]] bool is_shard_by_timings() const noexcept { return shard_by_timings; }
+
+  static std::vector<std::size_t> balance_shards(const std::vector<double>& runtimes, std::size_t count);
+  static std::unordered_map<std::string, double> read_timings(const std::string& path);
+
+  /**
+   * @brief Only run the examples whose full description matches `pattern`
+   *
+   * The full description is the one TAP reports: the descriptions of the
+   * enclosing contexts and the example, joined by spaces. An unnamed
+   * example is only described by its first expectation once it has run, so
+   * it can also be matched by its `FILE:LINE`. Given several patterns
+   * and/or locations, examples matching any of them are run.
+   *
+   * @param pattern a regular expression to search for
+   * @return a reference to the modified Runner
+   * @throws std::regex_error if `pattern` isn't a valid regular expression
+   */
+  Runner& add_example_filter(const std::string& pattern) {
+    filters.emplace_back([regex = std::regex{pattern}](const ItBase& it) {
+      if (std::regex_search(it.get_full_description(), regex)) {
+        return true;
+      }
+      std::source_location location = it.get_location();
+      return it.get_description().empty() &&
+             std::regex_search(std::format("{}:{}", location.file_name(), location.line()), regex);
+    });
+    return *this;
+  }
+
+  /**
+   * @brief Only run the examples declared at `file:line`, or inside a
+   * `describe` or `context` declared there
+   *
+   * @param file the name of the file, or any trailing part of its path
+   * @param line the line the example, describe or context starts on
+   * @return a reference to the modified Runner
+   */
+  Runner& add_location_filter(std::string file, std::uint_least32_t line) {
+    filters.emplace_back([file = std::move(file), line](const ItBase& it) {
+      for (const Runnable* runnable = &it; runnable != nullptr; runnable = runnable->get_parent()) {
+        if (matches_location(runnable->get_location(), file, line)) {
+          return true;
+        }
+      }
+      return false;
+    });
+    return *this;
+  }
+
+  static bool matches_location(std::source_location location, std::string_view file, std::uint_least32_t line);
+
+  /**
+   * @brief Keep track of which examples failed in `path`
+   *
+   * After every run, the examples that failed (or errored) are added to the
+   * file and those that passed are removed from it. Examples that didn't run
+   * keep whatever status they had.
+   *
+   * @param path the file to record failures in
+   * @return a reference to the modified Runner
+   */
+  Runner& set_failures_file(std::string path) {
+    failures_file = std::move(path);
+    return *this;
+  }
+  [[nodiscard]] const std::string& get_failures_file() const noexcept { return failures_file; }
+
+  /**
+   * @brief Only run the examples recorded as failed in the failures file
+   *
+   * If there is no failures file yet, everything is run.
+   *
+   * @param only_failures whether to only run failed examples
+   * @return a reference to the modified Runner
+   */
+  Runner& set_only_failures(bool only_failures) noexcept {
+    this->only_failures = only_failures;
+    return *this;
+  }
+  [[nodiscard]] bool is_only_failures() const noexcept { return only_failures; }
+
+  /**
+   * @brief Cache the results of passing runs in `path`, and replay them
+   * instead of running anything while the spec binary stays the same
+   *
+   * A run is replayed when every example it selects passed in an earlier
+   * run of the same build. Cached runtimes are those of the original run.
+   * Only use this for specs whose outcome depends on nothing but the
+   * binary: changes to files or services they rely on go unnoticed.
+   *
+   * @param path the file to keep cached results in
+   * @param build_id identifies the build of the spec binary, see ResultCache::build_id
+   * @return a reference to the modified Runner
+   */
+  Runner& set_result_cache(std::string path, std::uint64_t build_id) {
+    result_cache = std::move(path);
+    this->build_id = build_id;
+    return *this;
+  }
+  [[nodiscard]] const std::string& get_result_cache() const noexcept { return result_cache; }
+
+  /**
+   * @brief After the formatters, report the `count` slowest examples and
+   * the `count` slowest describes/contexts. See Profile.
+   *
+   * @param count how many of each to report, or 0 for no report
+   * @param out where to print the report
+   * @return a reference to the modified Runner
+   */
+  Runner& set_profile(std::size_t count, std::ostream& out = std::cout) noexcept {
+    profile_count = count;
+    profile_stream = &out;
+    return *this;
+  }
+  [[nodiscard]] std::size_t get_profile() const noexcept { return profile_count; }
+
+  static std::string example_id(const ItBase& it);
+  static std::optional<std::set<std::string>> read_failures(const std::string& path);
+
   Result run(std::source_location location = std::source_location::current()) {
-    bool success = true;
+    // Build every tree before running anything
     for (Description* spec : specs) {
-      spec->timed_run();
-      success &= !spec->get_result().is_failure();
+      spec->discover();
     }
-    for (auto& formatter : formatters) {
+
+    select_examples();
+    shuffle();
+    // Taken before running, while generated descriptions are still empty
+    bool needs_ids = !failures_file.empty() || !result_cache.empty() || !timings_file.empty();
+    ExampleIds examples = needs_ids ? selected_example_ids() : ExampleIds{};
+
+    std::optional<ResultCache> cache;
+    if (!result_cache.empty()) {
+      cache.emplace(result_cache, build_id);
+    }
+    auto started = std::chrono::steady_clock::now();
+    bool replayed = cache && !examples.empty() && cache->replay(examples);
+    if (replayed) {
+      std::cerr << "Replayed the cached results of " << examples.size() << " example(s)" << std::endl;
+    } else {
+      RunControl control{max_failures};
+      control.default_timeout = timeout;
+      control.fail_on_leaks = fail_on_leaks;
       for (Description* spec : specs) {
-        formatter->format(static_cast<Runnable&>(*spec));
+        spec->set_run_control(&control);
       }
+      execute(control);
+      for (Description* spec : specs) {
+        spec->set_run_control(nullptr);
+      }
+    }
+    Profile::Seconds wall_time = std::chrono::steady_clock::now() - started;
+    if (replayed) {
+      // Nothing ran, so report the wall time of the run that was cached
+      wall_time = {};
+      for (Description* spec : specs) {
+        wall_time += spec->get_runtime();
+      }
+    }
+    if (!failures_file.empty()) {
+      record_failures(examples);
+    }
+    if (!timings_file.empty()) {
+      record_timings(examples);
+    }
+
+    // Results are only reported once everything has finished, in the
+    // order the specs were added (or shuffled into), so output doesn't
+    // depend on `jobs`.
+    // Timeouts, crashed workers and exceptions are errors rather than
+    // failures, and fail the run just the same.
+    bool success = true;
+    for (Description* spec : specs) {
+      Result result = spec->get_result();
+      success &= !(result.is_failure() || result.is_error());
+    }
+    if (cache && success && !replayed) {
+      cache->store(examples);
+    }
+    format_results();
+    if (profile_count > 0) {
+      Profile{specs, wall_time}.print(*profile_stream, profile_count);
     }
     return success ? Result::success(location) : Result::failure(location);
   }
@@ -58,4 +559,399 @@ class Runner {
   Result exec() { return run(); }
 };
 
+/**
+ * @brief Get the shard (out of `count`) that an example belongs to.
+ */
+inline std::size_t Runner::shard_of(const ItBase& it, std::size_t count) {
+  std::source_location location = it.get_location();
+  std::uint64_t hash = Util::stable_hash(it.get_full_description());
+  hash = Util::stable_hash(location.file_name(), hash);
+  hash = Util::stable_hash(std::format(":{}:{}", location.line(), location.column()), hash);
+  return static_cast<std::size_t>(hash % count);
+}
+
+/**
+ * @brief Check whether a location is on `line` of a file whose path ends with `file`.
+ */
+inline bool Runner::matches_location(std::source_location location,
+                                     std::string_view file,
+                                     std::uint_least32_t line) {
+  std::string_view path = location.file_name();
+  if (location.line() != line || !path.ends_with(file)) {
+    return false;
+  }
+  // Only match whole path components, so "a_spec.cpp" doesn't match "data_spec.cpp"
+  if (path.size() == file.size()) {
+    return true;
+  }
+  char separator = path[path.size() - file.size() - 1];
+  return separator == '/' || separator == '\\';
+}
+
+/**
+ * @brief Get an ID for an example that stays the same from one build to the
+ * next as long as the example isn't moved or renamed: its source location
+ * followed by its description and those of every Description containing it.
+ */
+inline std::string Runner::example_id(const ItBase& it) {
+  std::source_location location = it.get_location();
+  std::forward_list<std::string> descriptions;
+  if (!it.get_description().empty()) {
+    descriptions.push_front(it.get_description());
+  }
+  for (const auto* parent = it.get_parent_as<Description>(); parent != nullptr;
+       parent = parent->has_parent() ? parent->get_parent_as<Description>() : nullptr) {
+    descriptions.push_front(parent->get_description());
+  }
+  std::string id = std::format("{}:{}:{} {}", location.file_name(), location.line(), location.column(),
+                               Util::join(descriptions, " "));
+  std::ranges::replace(id, '\n', ' ');  // One ID per line
+  return id;
+}
+
+/**
+ * @brief Read the IDs of the examples recorded in a failures file.
+ * @return the IDs, or nothing if the file doesn't exist
+ */
+inline std::optional<std::set<std::string>> Runner::read_failures(const std::string& path) {
+  std::ifstream file{path};
+  if (!file) {
+    return std::nullopt;
+  }
+  std::set<std::string> ids;
+  for (std::string line; std::getline(file, line);) {
+    if (!line.empty() && !line.starts_with('#')) {
+      ids.insert(std::move(line));
+    }
+  }
+  return ids;
+}
+
+/**
+ * @brief The IDs of every example that is currently selected.
+ */
+inline ExampleIds Runner::selected_example_ids() const {
+  ExampleIds examples;
+  std::function<void(Runnable&)> collect = [&](Runnable& runnable) {
+    if (!runnable.is_selected()) {
+      return;
+    }
+    if (auto* it = dynamic_cast<ItBase*>(&runnable)) {
+      examples.emplace_back(it, example_id(*it));
+    }
+    for (const auto& child : runnable.get_children()) {
+      collect(*child);
+    }
+  };
+  for (Description* spec : specs) {
+    collect(*spec);
+  }
+  return examples;
+}
+
+/**
+ * @brief Update the failures file with the outcome of the examples that ran.
+ *
+ * `examples` were selected before the run; those that are no longer selected
+ * (e.g. because of `--fail-fast`) didn't run and keep their old status.
+ */
+inline void Runner::record_failures(const ExampleIds& examples) const {
+  std::set<std::string> failed = read_failures(failures_file).value_or(std::set<std::string>{});
+  for (const auto& [it, id] : examples) {
+    if (!it->is_selected()) {
+      continue;
+    }
+    Result result = it->get_result();
+    if (result.is_failure() || result.is_error()) {
+      failed.insert(id);
+    } else {
+      failed.erase(id);
+    }
+  }
+
+  std::ofstream file{failures_file, std::ios::trunc};
+  if (!file) {
+    std::cerr << "Could not write failures to " << failures_file << std::endl;
+    return;
+  }
+  file << "# Examples that failed when last run, for --only-failures" << std::endl;
+  for (const std::string& id : failed) {
+    file << id << '\n';
+  }
+}
+
+/**
+ * @brief Read the runtimes (in seconds) of the examples in a timings file.
+ *
+ * An example listed more than once takes its last runtime.
+ */
+inline std::unordered_map<std::string, double> Runner::read_timings(const std::string& path) {
+  std::unordered_map<std::string, double> timings;
+  std::ifstream file{path};
+  for (std::string line; std::getline(file, line);) {
+    auto space = line.find(' ');
+    if (line.starts_with('#') || space == std::string::npos) {
+      continue;
+    }
+    double seconds = 0;
+    auto [ptr, ec] = std::from_chars(line.data(), line.data() + space, seconds);
+    if (ec == std::errc{} && ptr == line.data() + space) {
+      timings.insert_or_assign(line.substr(space + 1), seconds);
+    }
+  }
+  return timings;
+}
+
+/**
+ * @brief Update the timings file with the runtimes of the examples that ran,
+ * or write them to a file of their own for a shard.
+ */
+inline void Runner::record_timings(const ExampleIds& examples) const {
+  bool sharded = shard_count > 1;
+  std::string path = sharded ? std::format("{}.shard-{}", timings_file, shard_index) : timings_file;
+  std::unordered_map<std::string, double> timings = sharded ? decltype(timings){} : read_timings(timings_file);
+  for (const auto& [it, id] : examples) {
+    if (it->is_selected()) {
+      timings.insert_or_assign(id, it->get_runtime().count());
+    }
+  }
+
+  // Sorted, so that the file diffs well if it's kept in version control
+  std::vector<std::pair<std::string, double>> sorted{timings.begin(), timings.end()};
+  std::ranges::sort(sorted);
+  std::ofstream file{path, std::ios::trunc};
+  if (!file) {
+    std::cerr << "Could not write timings to " << path << std::endl;
+    return;
+  }
+  file << "# Runtimes of examples in seconds, for --shard-by timings" << std::endl;
+  for (const auto& [id, seconds] : sorted) {
+    file << std::format("{:.6f} {}\n", seconds, id);
+  }
+}
+
+/**
+ * @brief Assign jobs of the given runtimes to `count` shards, so that every
+ * shard takes about as long as the others.
+ *
+ * The longest jobs are handed out first, each to the shard with the least
+ * work so far. Ties go the same way every time.
+ *
+ * @return the shard of each job
+ */
+inline std::vector<std::size_t> Runner::balance_shards(const std::vector<double>& runtimes, std::size_t count) {
+  std::vector<std::size_t> order(runtimes.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::ranges::stable_sort(order, [&runtimes](std::size_t a, std::size_t b) { return runtimes[a] > runtimes[b]; });
+
+  std::vector<double> totals(count, 0.0);
+  std::vector<std::size_t> shards(runtimes.size());
+  for (std::size_t job : order) {
+    auto lightest = static_cast<std::size_t>(std::ranges::min_element(totals) - totals.begin());
+    shards[job] = lightest;
+    totals[lightest] += runtimes[job];
+  }
+  return shards;
+}
+
+/**
+ * @brief Deselect every example that isn't part of this Runner's shard.
+ */
+inline void Runner::select_shard() {
+  if (!shard_by_timings) {
+    for (Description* spec : specs) {
+      spec->select_examples([this](const ItBase& it) { return shard_of(it, shard_count) == shard_index; });
+    }
+    return;
+  }
+
+  ExampleIds examples = selected_example_ids();
+  std::unordered_map<std::string, double> timings = read_timings(timings_file);
+  double known = 0;
+  std::size_t known_count = 0;
+  for (const auto& [it, id] : examples) {
+    if (auto timing = timings.find(id); timing != timings.end()) {
+      known += timing->second;
+      known_count++;
+    }
+  }
+  double average = known_count == 0 ? 1.0 : known / static_cast<double>(known_count);
+
+  std::vector<double> runtimes;
+  runtimes.reserve(examples.size());
+  for (const auto& [it, id] : examples) {
+    auto timing = timings.find(id);
+    runtimes.push_back(timing != timings.end() ? timing->second : average);
+  }
+
+  std::vector<std::size_t> shards = balance_shards(runtimes, shard_count);
+  std::unordered_map<const ItBase*, std::size_t> shard_of_example;
+  for (std::size_t i = 0; i < examples.size(); ++i) {
+    shard_of_example.emplace(examples[i].first, shards[i]);
+  }
+  for (Description* spec : specs) {
+    spec->select_examples([&](const ItBase& it) { return shard_of_example.at(&it) == shard_index; });
+  }
+}
+
+/**
+ * @brief Deselect every example that doesn't match a filter, (with
+ * `--only-failures`) didn't fail last time, or isn't part of this Runner's
+ * shard.
+ */
+inline void Runner::select_examples() {
+  if (!filters.empty()) {
+    for (Description* spec : specs) {
+      spec->select_examples([this](const ItBase& it) {
+        return std::ranges::any_of(filters, [&it](const Description::Predicate& filter) { return filter(it); });
+      });
+    }
+  }
+  if (only_failures && !failures_file.empty()) {
+    if (auto failed = read_failures(failures_file)) {
+      for (Description* spec : specs) {
+        spec->select_examples([&failed](const ItBase& it) { return failed->contains(example_id(it)); });
+      }
+    }
+  }
+  // Last, so that shards are balanced over the examples that will actually run
+  if (shard_count > 1) {
+    select_shard();
+  }
+}
+
+/**
+ * @brief Shuffle the specs and everything in them, if running in random order.
+ */
+inline void Runner::shuffle() {
+  if (!seed) {
+    return;
+  }
+  std::cerr << "Randomized with seed " << *seed << std::endl;
+
+  std::mt19937_64 rng{*seed};
+  std::vector<Description*> shuffled{specs.begin(), specs.end()};
+  for (std::size_t i = shuffled.size(); i > 1; --i) {
+    std::swap(shuffled[i - 1], shuffled[rng() % i]);
+  }
+  specs.assign(shuffled.begin(), shuffled.end());
+  for (Description* spec : specs) {
+    spec->shuffle_children(rng);
+  }
+}
+
+/**
+ * @brief Pass every spec to the formatters, in the order the specs were
+ * added (or shuffled into).
+ */
+inline void Runner::format_results() {
+  for (auto& formatter : formatters) {
+    for (Description* spec : specs) {
+      formatter->format(static_cast<Runnable&>(*spec));
+    }
+  }
+}
+
+/**
+ * @brief Report what has finished, as the Watchdog gives up on the run
+ * because an example is still running long after its timeout.
+ *
+ * This runs on the Watchdog's thread, while the hung example (and, with
+ * more than one job, others) may still be running, so the formatters are
+ * given copies of the examples that had finished, along with one of the
+ * hung example as having timed out. Examples still running elsewhere, and
+ * those that never started, are left out.
+ */
+inline void Runner::report_hung(const Snapshot::Hung& hung, const Snapshot::Finished& finished) {
+  std::list<Snapshot::Described> copies;
+  for (Description* spec : specs) {
+    auto& copy = copies.emplace_back(*spec);
+    copy.set_selected(Snapshot::copy_finished(*spec, copy, finished, hung));
+  }
+  for (auto& formatter : formatters) {
+    for (auto& copy : copies) {
+      formatter->format(static_cast<Runnable&>(copy));
+    }
+  }
+  formatters.clear();  // Formatters such as JUnitXML only write out when they're destroyed
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+}
+
+/**
+ * @brief Whether any selected example beneath `runnable` has a timeout.
+ */
+inline bool Runner::has_timeouts(const Runnable& runnable) {
+  if (!runnable.is_selected()) {
+    return false;
+  }
+  if (const auto* it = dynamic_cast<const ItBase*>(&runnable)) {
+    return it->get_parent_as<Description>()->timeout_for(*it).has_value();
+  }
+  return std::ranges::any_of(runnable.get_children(), [](const Runnable* child) { return has_timeouts(*child); });
+}
+
+/**
+ * @brief Run every spec, spreading the work over `jobs` threads.
+ *
+ * Each top-level spec becomes a task on a work-stealing Scheduler. The
+ * Descriptions then hand their own children to the same Scheduler, so
+ * idle workers can take single examples out of a large `describe`.
+ * Isolated runs use `jobs` worker processes instead, one spec each.
+ */
+inline void Runner::execute([[maybe_unused]] RunControl& control) {
+#if !defined(CPPSPEC_SEMIHOSTED) && !defined(_WIN32)
+  if (isolated) {
+    Isolation::run(specs, jobs, control);
+    return;
+  }
+#endif
+#ifndef CPPSPEC_SEMIHOSTED
+  // The examples that have finished, which are all that can be reported
+  // safely if the run is given up on. Only kept when something might hang.
+  std::mutex finished_mutex;
+  Snapshot::Finished finished;
+  if (std::ranges::any_of(specs, [](const Description* spec) { return has_timeouts(*spec); })) {
+    control.on_finished = [&](ItBase& it) {
+      std::lock_guard lock{finished_mutex};
+      finished.insert(&it);
+    };
+  }
+
+  // Only start watching for hung examples once one with a timeout starts
+  std::once_flag watchdog_started;
+  std::optional<Watchdog> watchdog;
+  control.on_timed_start = [&](ItBase& it, RunControl::Seconds timeout) {
+    std::call_once(watchdog_started, [&] {
+      watchdog.emplace([&](const ItBase& hung, const std::string& name, RunControl::Seconds limit) {
+        control.stop();
+        std::lock_guard lock{finished_mutex};
+        report_hung({.example = &hung, .name = name, .timeout = limit}, finished);
+      });
+    });
+    watchdog->start(it, timeout);
+  };
+  control.on_timed_finish = [&](ItBase& it) { watchdog->finish(it); };
+
+  if (jobs > 1) {
+    Scheduler scheduler{jobs};
+    TaskGroup group{scheduler};
+    for (Description* spec : specs) {
+      if (spec->is_selected()) {
+        group.spawn([spec] { spec->timed_run(); });
+      }
+    }
+    group.wait();
+  } else
+#endif
+  {
+    for (Description* spec : specs) {
+      if (spec->is_selected()) {
+        spec->timed_run();
+      }
+    }
+  }
+}
+
 }  // namespace CppSpec
@@ -0,0 +1,250 @@
+/**
+ * @file
+ * @brief A work-stealing scheduler for running examples in parallel
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace CppSpec {
+
+/**
+ * @brief A pool of worker threads that share work by stealing it.
+ *
+ * Every worker owns a deque of tasks. A worker pushes the tasks it spawns
+ * onto the back of its own deque and takes work from the back too, so it
+ * finishes a subtree before starting another. Idle workers steal from the
+ * front of other workers' deques, which holds the oldest (and usually
+ * largest) pieces of work.
+ *
+ * A thread that isn't one of the pool's workers (i.e. the one that created
+ * the Scheduler) uses deque 0 while it helps out in TaskGroup::wait.
+ */
+class Scheduler {
+ public:
+  using Task = std::function<void()>;
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  struct ThreadState {
+    Scheduler* scheduler = nullptr;
+    std::size_t index = 0;
+  };
+
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+  std::size_t epoch_ = 0;  // Bumped whenever a task is queued or a group finishes
+  bool stopping_ = false;
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::jthread> threads_;  // Last, so the workers are joined first
+
+  static ThreadState& this_thread() noexcept {
+    thread_local ThreadState state;
+    return state;
+  }
+
+  std::optional<Task> take(std::size_t index);
+  void work(std::size_t index);
+  void notify();
+
+  template <typename Done>
+  void help_until(Done done);
+
+  friend class TaskGroup;
+
+ public:
+  /**
+   * @param jobs the total number of threads to run tasks on, including the
+   *             thread that waits for them
+   */
+  explicit Scheduler(std::size_t jobs);
+  ~Scheduler();
+
+  Scheduler(const Scheduler&) = delete;
+  Scheduler& operator=(const Scheduler&) = delete;
+
+  /** @brief The scheduler the calling thread is running tasks for, if any */
+  static Scheduler* current() noexcept { return this_thread().scheduler; }
+
+  [[nodiscard]] std::size_t get_jobs() const noexcept { return queues_.size(); }
+
+  void push(Task task);
+};
+
+/**
+ * @brief A set of tasks that can be waited on together.
+ *
+ * Waiting doesn't block the thread: it keeps running queued tasks (its own
+ * or stolen ones) until every task in the group has finished, so nested
+ * groups can't starve the pool.
+ */
+class TaskGroup {
+  Scheduler& scheduler_;
+  std::atomic<std::size_t> pending_{0};
+
+ public:
+  explicit TaskGroup(Scheduler& scheduler) : scheduler_(scheduler) {}
+  ~TaskGroup() { wait(); }
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  template <typename F>
+  void spawn(F&& f) {
+    ++pending_;
+    // The group may be gone as soon as the last task is done, so
+    // don't touch `this` after that.
+    scheduler_.push([this, scheduler = &scheduler_, f = std::forward<F>(f)]() mutable {
+      f();
+      if (--pending_ == 0) {
+        scheduler->notify();
+      }
+    });
+  }
+
+  void wait() {
+    scheduler_.help_until([this] { return pending_ == 0; });
+  }
+};
+
+/*>>>>>>>>>>>>>>>>>>>> Scheduler <<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+inline Scheduler::Scheduler(std::size_t jobs) {
+  jobs = std::max<std::size_t>(jobs, 1);
+  queues_.reserve(jobs);
+  for (std::size_t i = 0; i < jobs; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  threads_.reserve(jobs - 1);
+  for (std::size_t i = 1; i < jobs; ++i) {
+    threads_.emplace_back([this, i] { work(i); });
+  }
+}
+
+inline Scheduler::~Scheduler() {
+  {
+    std::lock_guard lock(idle_mutex_);
+    stopping_ = true;
+  }
+  idle_cv_.notify_all();
+}
+
+/**
+ * @brief Queue a task on the calling thread's deque.
+ */
+inline void Scheduler::push(Task task) {
+  ThreadState& state = this_thread();
+  std::size_t index = state.scheduler == this ? state.index : 0;
+  {
+    std::lock_guard lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard lock(idle_mutex_);
+    ++epoch_;
+  }
+  idle_cv_.notify_one();
+}
+
+/**
+ * @brief Wake up everyone waiting for work, e.g. because a group finished.
+ */
+inline void Scheduler::notify() {
+  {
+    std::lock_guard lock(idle_mutex_);
+    ++epoch_;
+  }
+  idle_cv_.notify_all();
+}
+
+/**
+ * @brief Find a task for the worker at `index`: the newest one on its own
+ * deque, or else the oldest one on somebody else's.
+ */
+inline std::optional<Scheduler::Task> Scheduler::take(std::size_t index) {
+  {
+    Queue& own = *queues_[index];
+    std::lock_guard lock(own.mutex);
+    if (!own.tasks.empty()) {
+      Task task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return task;
+    }
+  }
+  for (std::size_t i = 1; i < queues_.size(); ++i) {
+    Queue& victim = *queues_[(index + i) % queues_.size()];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      Task task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return task;
+    }
+  }
+  return std::nullopt;
+}
+
+inline void Scheduler::work(std::size_t index) {
+  this_thread() = {this, index};
+  while (true) {
+    std::size_t epoch = 0;
+    {
+      std::lock_guard lock(idle_mutex_);
+      if (stopping_) {
+        return;
+      }
+      epoch = epoch_;
+    }
+    if (auto task = take(index)) {
+      (*task)();
+      continue;
+    }
+    std::unique_lock lock(idle_mutex_);
+    idle_cv_.wait(lock, [&] { return stopping_ || epoch_ != epoch; });
+  }
+}
+
+/**
+ * @brief Run tasks on the calling thread until `done()` returns true.
+ */
+template <typename Done>
+void Scheduler::help_until(Done done) {
+  ThreadState& state = this_thread();
+  ThreadState previous = state;
+  if (state.scheduler != this) {
+    state = {this, 0};
+  }
+
+  while (!done()) {
+    std::size_t epoch = 0;
+    {
+      std::lock_guard lock(idle_mutex_);
+      epoch = epoch_;
+    }
+    if (auto task = take(state.index)) {
+      (*task)();
+      continue;
+    }
+    std::unique_lock lock(idle_mutex_);
+    idle_cv_.wait(lock, [&] { return done() || epoch_ != epoch; });
+  }
+
+  state = previous;
+}
+
+}  // namespace CppSpec
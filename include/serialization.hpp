@@ -0,0 +1,76 @@
+/**
+ * @file
+ * @brief A minimal binary format for passing results between processes
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace CppSpec::Serialization {
+
+/**
+ * @brief Serializes values into a flat buffer, to be sent over a pipe or
+ * written to a file.
+ */
+class Writer {
+  std::string buffer_;
+
+ public:
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void write(const T& value) {
+    buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void write_string(std::string_view str) {
+    write(std::uint64_t{str.size()});
+    buffer_.append(str);
+  }
+
+  [[nodiscard]] const std::string& str() const noexcept { return buffer_; }
+};
+
+/**
+ * @brief Reads back values written by a Writer.
+ *
+ * Every read returns false instead of reading past the end of the data,
+ * which is what a child that died halfway through writing (or a truncated
+ * file) leaves behind.
+ */
+class Reader {
+  std::string_view data_;
+
+ public:
+  explicit Reader(std::string_view data) noexcept : data_(data) {}
+
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  bool read(T& value) noexcept {
+    if (data_.size() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data_.data(), sizeof(T));
+    data_.remove_prefix(sizeof(T));
+    return true;
+  }
+
+  bool read_string(std::string& str) {
+    std::uint64_t size = 0;
+    if (!read(size) || data_.size() < size) {
+      return false;
+    }
+    str.assign(data_.substr(0, size));
+    data_.remove_prefix(size);
+    return true;
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return data_.empty(); }
+  [[nodiscard]] std::size_t remaining() const noexcept { return data_.size(); }
+};
+
+}  // namespace CppSpec::Serialization
@@ -3,11 +3,18 @@
  * @brief Utility functions and classes
  */
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <mutex>
 #include <ranges>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 
 #ifdef __GNUG__
 #include <cxxabi.h>
@@ -40,6 +47,27 @@ inline std::string demangle(const char* name) {
 }
 #endif
 
+/**
+ * @brief Demangle the name of a type, once per type per process
+ *
+ * The names are kept for the lifetime of the program, so the returned
+ * reference stays valid.
+ *
+ * @param type the type to name
+ *
+ * @return a human-readable name for the given type
+ */
+inline const std::string& demangle(const std::type_info& type) {
+  static std::mutex mutex;
+  static std::unordered_map<std::type_index, std::string> names;
+  std::scoped_lock lock{mutex};
+  auto it = names.find(type);
+  if (it == names.end()) {
+    it = names.emplace(type, demangle(type.name())).first;
+  }
+  return it->second;
+}
+
 /**
  * @brief Helper class for static assertions that has a built-in error string.
  */
@@ -106,6 +134,37 @@ template <typename T>
 concept not_c_string = !std::is_same_v<T, const char*> && !std::is_same_v<T, char*> &&
                        !std::is_convertible_v<T, const char*> && !std::is_convertible_v<T, char*>;
 
+/**
+ * @brief Checks whether a value of T can still be printed after whatever it
+ * was copied from is gone, i.e. it doesn't refer to anything else.
+ *
+ * Pointers other than `void*` are left out, since C strings are printed
+ * through them.
+ *
+ * @tparam T a type to check
+ */
+template <typename T>
+concept is_self_contained = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_null_pointer_v<T> ||
+                            std::is_same_v<T, void*> || std::is_same_v<T, std::string>;
+
+/**
+ * @brief A string literal that can be passed as a template argument
+ *
+ * @code
+ *   template <Util::fixed_string S>
+ *   std::string_view name() { return S.view(); }
+ *
+ *   name<"hello">();
+ * @endcode
+ */
+template <std::size_t N>
+struct fixed_string {
+  char chars[N]{};
+
+  constexpr fixed_string(const char (&string)[N]) { std::copy_n(string, N, chars); }
+  [[nodiscard]] constexpr std::string_view view() const { return {chars, N - 1}; }
+};
+
 /**
  * @brief Implode a string
  *
@@ -142,4 +201,24 @@ concept not_c_string = !std::is_same_v<T, const char*> && !std::is_same_v<T, cha
   return oss.str();
 }
 
+/**
+ * @brief A 64-bit FNV-1a hash of a string
+ *
+ * Unlike std::hash, the result is the same on every platform and
+ * standard library, so it can be used to split work between machines.
+ *
+ * @param data the bytes to hash
+ * @param hash the hash to continue from, for hashing several strings in turn
+ *
+ * @return the hash of `data`
+ */
+[[nodiscard]] constexpr std::uint64_t stable_hash(std::string_view data,
+                                                  std::uint64_t hash = 14695981039346656037ULL) noexcept {
+  for (char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 }  // namespace CppSpec::Util
@@ -0,0 +1,138 @@
+/**
+ * @file
+ * @brief A thread that notices examples that have hung
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "description.hpp"
+
+namespace CppSpec {
+
+/**
+ * @brief Watches running examples and gives up on the run when one of them
+ * is still running well after its timeout.
+ *
+ * An example that finishes late is simply reported as an error, but one
+ * that never finishes can't be stopped from inside the process. Once an
+ * example has been running for twice its timeout, the Watchdog names it on
+ * stderr, lets its owner report what has run so far, and exits, so that a
+ * hung example doesn't stall CI indefinitely. Use `--isolate` to instead
+ * have the spec's process killed and the rest of the run carry on.
+ */
+class Watchdog {
+  using Clock = std::chrono::steady_clock;
+
+ public:
+  // Called on the Watchdog's thread with the hung example, its own description
+  // and its timeout, just before it exits
+  using GiveUp = std::function<void(const ItBase&, const std::string&, std::chrono::duration<double>)>;
+
+ private:
+  struct Watch {
+    Clock::time_point deadline;
+    std::chrono::duration<double> timeout;
+    std::string description;  // Taken when the example starts, as it may change while it runs
+    std::string name;         // Its own description, without those of its Descriptions
+    std::source_location location;
+  };
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::map<ItBase*, Watch> watched_;
+  GiveUp on_give_up_;
+  bool stopping_ = false;
+  std::jthread thread_;  // Last, so it's joined before the rest is destroyed
+
+  void watch();
+  [[noreturn]] void give_up(const ItBase& it, const Watch& hung);
+
+ public:
+  explicit Watchdog(GiveUp on_give_up = {}) : on_give_up_(std::move(on_give_up)), thread_([this] { watch(); }) {}
+
+  Watchdog(const Watchdog&) = delete;
+  Watchdog& operator=(const Watchdog&) = delete;
+
+  ~Watchdog() {
+    {
+      std::lock_guard lock{mutex_};
+      stopping_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  /**
+   * @brief Start watching an example. Called on the thread that runs it.
+   */
+  void start(ItBase& it, std::chrono::duration<double> timeout) {
+    auto grace = std::chrono::duration_cast<Clock::duration>(timeout * 2);
+    Watch example{
+        .deadline = Clock::now() + grace,
+        .timeout = timeout,
+        .description = it.get_full_description(),
+        .name = it.get_description(),
+        .location = it.get_location(),
+    };
+    {
+      std::lock_guard lock{mutex_};
+      watched_.insert_or_assign(&it, std::move(example));
+    }
+    cv_.notify_all();
+  }
+
+  void finish(ItBase& it) {
+    std::lock_guard lock{mutex_};
+    watched_.erase(&it);
+  }
+};
+
+inline void Watchdog::watch() {
+  std::unique_lock lock{mutex_};
+  while (!stopping_) {
+    if (watched_.empty()) {
+      cv_.wait(lock);
+      continue;
+    }
+
+    auto next = watched_.begin();
+    for (auto entry = watched_.begin(); entry != watched_.end(); ++entry) {
+      if (entry->second.deadline < next->second.deadline) {
+        next = entry;
+      }
+    }
+    Clock::time_point deadline = next->second.deadline;  // `next` may be erased while we wait
+    if (Clock::now() >= deadline) {
+      give_up(*next->first, next->second);
+    }
+    cv_.wait_until(lock, deadline);
+  }
+}
+
+inline void Watchdog::give_up(const ItBase& it, const Watch& hung) {
+  std::cerr << std::endl
+            << "Example \"" << hung.description << "\" at " << hung.location.file_name() << ":"
+            << hung.location.line() << " timed out after " << hung.timeout.count()
+            << "s and is still running; giving up on the run." << std::endl
+            << "Run with --isolate to run the remaining examples." << std::endl;
+  if (on_give_up_) {
+    try {
+      on_give_up_(it, hung.name, hung.timeout);
+    } catch (...) {
+      // Exit all the same
+    }
+  }
+  std::_Exit(EXIT_FAILURE);
+}
+
+}  // namespace CppSpec
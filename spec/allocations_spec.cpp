@@ -0,0 +1,138 @@
+#define CPPSPEC_TRACK_ALLOCATIONS
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+namespace {
+std::unique_ptr<int[]> kept;  // Allocated by one example and freed by another
+
+ItBase& only_example(Description& spec) {
+  return *dynamic_cast<ItBase*>(spec.get_children().front());
+}
+}  // namespace
+
+describe allocations_spec("Allocation tracking", $ {
+  it("counts the allocations an example makes", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("allocates", _ {
+        std::vector<int> v(100);
+        auto s = std::make_unique<std::string>(64, 'x');
+      });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec});
+    const auto& allocations = only_example(spec).get_allocations();
+    expect(allocations.has_value()).to_be_true();
+    expect(allocations->allocations >= 2).to_be_true();
+    expect(allocations->bytes >= 100 * sizeof(int) + 64).to_be_true();
+    expect(allocations->live_bytes).to_equal(std::int64_t{0});
+    expect(only_example(spec).get_result().is_success()).to_be_true();
+  });
+
+  it("doesn't count the results of expectations", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("expects", _ { expect(1).to_equal(1); });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec});
+    expect(only_example(spec).get_allocations()->allocations).to_equal(std::uint64_t{0});
+  });
+
+  it("flags an example that leaks, without failing it", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("leaks", _ { kept = std::make_unique<int[]>(4); });
+    });
+    // clang-format on
+    auto run = SpecHelper::run_specs({spec});
+    kept.reset();
+    expect(run.success).to_be_true();
+    expect(only_example(spec).get_allocations()->leaked()).to_be_true();
+    expect(run.output.find("(flagged: possible leak)") != std::string::npos).to_be_true();
+  });
+
+  it("fails an example that leaks when the run fails on leaks", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("leaks", _ { kept = std::make_unique<int[]>(4); });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec}, [](Runner& runner) { runner.set_fail_on_leaks(true); });
+    kept.reset();
+    const auto& results = only_example(spec).get_results();
+    expect(only_example(spec).get_result().is_failure()).to_be_true();
+    expect(results.back().get_message()).to_equal(std::format("Leaked {} bytes in 1 allocations", 4 * sizeof(int)));
+  });
+
+  it("fails an example whose expected block leaks when the run fails on leaks", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("leaks", _ {
+        expect([]() -> int {
+          kept = std::make_unique<int[]>(4);
+          throw std::runtime_error("thrown");
+        }).template to_throw<std::runtime_error>();
+      });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec}, [](Runner& runner) { runner.set_fail_on_leaks(true); });
+    kept.reset();
+    const auto& results = only_example(spec).get_results();
+    expect(only_example(spec).get_result().is_failure()).to_be_true();
+    expect(results.size()).to_equal(std::size_t{1});
+    expect(results.back().get_message()).to_equal(std::format("Leaked {} bytes in 1 allocations", 4 * sizeof(int)));
+  });
+
+  it("doesn't count memory freed that another example allocated", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("allocates", _ { kept = std::make_unique<int[]>(4); });
+      it("frees", _ { kept.reset(); });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec});
+    auto* frees = dynamic_cast<ItBase*>(spec.get_children().back());
+    expect(frees->get_allocations()->live_bytes).to_equal(std::int64_t{0});
+    expect(frees->get_result().is_success()).to_be_true();
+  });
+
+  it("shows the allocations in the verbose output", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("allocates", _ { std::vector<int> v(10); });
+    });
+    // clang-format on
+    std::string out = SpecHelper::run_specs({spec}).output;
+    expect(out.find(std::format("1 allocations, {} bytes, 0 bytes leaked", 10 * sizeof(int))) != std::string::npos)
+        .to_be_true();
+  });
+
+  it("adds the allocations to JUnit as properties", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("allocates", _ { std::vector<int> v(10); });
+    });
+    // clang-format on
+    std::ostringstream out;
+    {
+      auto formatter = std::make_shared<Formatters::JUnitXML>(out, false);
+      SpecHelper::run_with(formatter, {spec});
+    }
+    expect(out.str().find(R"(<property name="allocations.count" value="1"/>)") != std::string::npos).to_be_true();
+    expect(out.str().find(R"(<property name="allocations.leaked_bytes" value="0"/>)") != std::string::npos)
+        .to_be_true();
+    expect(out.str().find(R"(<property name="allocations.leak_flagged" value="false"/>)") != std::string::npos)
+        .to_be_true();
+  });
+});
+
+CPPSPEC_MAIN(allocations_spec);
@@ -0,0 +1,141 @@
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+using namespace std::chrono_literals;
+
+namespace {
+std::vector<std::string> events;
+int let_calls = 0;
+
+Result run_spec(Description& spec) {
+  SpecHelper::run_specs({spec});
+  return spec.get_result();
+}
+
+Task record_after(std::string event, std::chrono::milliseconds delay) {
+  co_await sleep_for(delay);
+  events.push_back(std::move(event));
+}
+}  // namespace
+
+describe async_spec("Asynchronous examples", $ {
+  before_each([] {
+    events.clear();
+    let_calls = 0;
+  });
+
+  it("runs examples that are waiting at the same time", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("waits", _async { co_await sleep_for(100ms); });
+      it("waits too", _async { co_await sleep_for(100ms); });
+      it("waits as well", _async { co_await sleep_for(100ms); });
+    });
+    // clang-format on
+    auto started = std::chrono::steady_clock::now();
+    expect(run_spec(spec).is_success()).to_be_true();
+    expect(std::chrono::steady_clock::now() - started < 250ms).to_be_true();
+  });
+
+  it("resumes whichever example is ready first", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("is slow", _async { co_await record_after("slow", 60ms); });
+      it("is fast", _async { co_await record_after("fast", 10ms); });
+    });
+    // clang-format on
+    run_spec(spec);
+    expect(events.size()).to_equal(std::size_t{2});
+    expect(events.front()).to_equal("fast");
+  });
+
+  it("records expectations made after resuming", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("fails late", _async {
+        co_await yield();
+        expect(1).to_equal(2);
+      });
+    });
+    // clang-format on
+    expect(run_spec(spec).is_failure()).to_be_true();
+  });
+
+  it("reports an exception thrown by an example as an error", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("throws", _async {
+        co_await yield();
+        throw std::runtime_error("oops");
+      });
+    });
+    // clang-format on
+    Result result = run_spec(spec);
+    expect(result.is_error()).to_be_true();
+    expect(result.get_message()).to_equal("oops");
+  });
+
+  it("awaits the value of a future", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("gets 42", _async {
+        int answer = co_await wait(std::async(std::launch::async, [] { return 42; }));
+        expect(answer).to_equal(42);
+      });
+    });
+    // clang-format on
+    expect(run_spec(spec).is_success()).to_be_true();
+  });
+
+  it("runs the hooks around each example", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      before_each([] { events.emplace_back("before"); });
+      after_each([] { events.emplace_back("after"); });
+      it("waits", _async { co_await record_after("example", 1ms); });
+    });
+    // clang-format on
+    run_spec(spec);
+    expect(events).to_equal(std::vector<std::string>{"before", "example", "after"});
+  });
+
+  it("keeps each example's let values across suspensions", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      let(value, [] { return ++let_calls; });
+      it("first", _async {
+        int before = *value;
+        co_await yield();
+        expect(*value).to_equal(before);
+      });
+      it("second", _async {
+        int before = *value;
+        co_await yield();
+        expect(*value).to_equal(before);
+      });
+    });
+    // clang-format on
+    expect(run_spec(spec).is_success()).to_be_true();
+    expect(let_calls).to_equal(2);
+  });
+
+  it("runs alongside ordinary examples", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("is ordinary", _ { events.emplace_back("ordinary"); });
+      it("is asynchronous", _async { co_await record_after("asynchronous", 1ms); });
+    });
+    // clang-format on
+    expect(run_spec(spec).is_success()).to_be_true();
+    expect(events.size()).to_equal(std::size_t{2});
+  });
+});
+
+CPPSPEC_MAIN(async_spec);
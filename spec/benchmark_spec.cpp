@@ -0,0 +1,143 @@
+#include <chrono>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+using namespace std::chrono_literals;
+
+namespace {
+int iterations = 0;
+int hooks = 0;
+
+// Quick enough that the specs don't take long
+constexpr BenchmarkOptions quick{.warmup = 1ms, .samples = 5, .sample_time = 1ms};
+
+}  // namespace
+
+describe benchmark_spec("benchmark", $ {
+  before_each([] {
+    iterations = 0;
+    hooks = 0;
+  });
+
+  it("times many iterations of its body, after running its hooks once", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      before_each([] { ++hooks; });
+      it_benchmark("counts", quick, _ { ++iterations; });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec});
+    auto* example = dynamic_cast<ItBase*>(spec.get_children().front());
+    const auto& stats = example->get_benchmark_stats();
+    expect(stats.has_value()).to_be_true();
+    expect(stats->samples).to_equal(std::uint64_t{5});
+    expect(iterations > static_cast<int>(stats->samples * stats->iterations)).to_be_true();
+    expect(hooks).to_equal(1);
+    expect(stats->min <= stats->median && stats->median <= stats->mean + stats->stddev * 3).to_be_true();
+  });
+
+  it("only counts the results of its first run", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it_benchmark("expects", quick, _ { expect(1).to_equal(1); });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec});
+    auto* example = dynamic_cast<ItBase*>(spec.get_children().front());
+    expect(example->get_success_count()).to_equal(std::size_t{1});
+    expect(example->get_result().is_success()).to_be_true();
+  });
+
+  it("isn't measured when its expectations fail", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it_benchmark("fails", quick, _ {
+        ++iterations;
+        expect(1).to_equal(2);
+      });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec});
+    auto* example = dynamic_cast<ItBase*>(spec.get_children().front());
+    expect(example->get_result().is_failure()).to_be_true();
+    expect(example->get_benchmark_stats().has_value()).to_be_false();
+    expect(iterations).to_equal(1);
+  });
+
+  it("stops measuring once its expectations fail", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it_benchmark("fails after its first run", quick, _ { expect(++iterations).to_equal(1); });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec});
+    auto* example = dynamic_cast<ItBase*>(spec.get_children().front());
+    expect(example->get_result().is_failure()).to_be_true();
+    expect(example->get_results().size()).to_equal(std::size_t{1});
+    expect(example->get_benchmark_stats().has_value()).to_be_false();
+  });
+
+  it("can benchmark the subject of a describe_a", _ {
+    // clang-format off
+    ClassDescription<std::vector<int>> spec("spec", {1, 2, 3}, $ {
+      it_benchmark("sums", quick, _ {
+        do_not_optimize(std::accumulate(subject.begin(), subject.end(), 0));
+      });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec});
+    auto* example = dynamic_cast<ItBase*>(spec.get_children().front());
+    expect(example->get_benchmark_stats().has_value()).to_be_true();
+  });
+
+  it("prints its statistics with the verbose formatter", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it_benchmark("counts", quick, _ { do_not_optimize(++iterations); });
+    });
+    // clang-format on
+    std::string out = SpecHelper::run_specs({spec}).output;
+    expect(out.find("counts\n") != std::string::npos).to_be_true();
+    expect(out.find("(5 samples of") != std::string::npos).to_be_true();
+  });
+
+  it("adds its statistics to JUnit as properties", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it_benchmark("counts", quick, _ { do_not_optimize(++iterations); });
+    });
+    // clang-format on
+    std::ostringstream out;
+    {
+      auto formatter = std::make_shared<Formatters::JUnitXML>(out, false);
+      SpecHelper::run_with(formatter, {spec});
+    }
+    expect(out.str().find(R"(<property name="benchmark.median_ns" value=")") != std::string::npos).to_be_true();
+    expect(out.str().find(R"(<property name="benchmark.samples" value="5"/>)") != std::string::npos).to_be_true();
+  });
+
+  context("statistics", _ {
+    it("are computed for each iteration", _ {
+      auto stats = BenchmarkStats::of({4, 1, 3, 2}, 10);
+      expect(stats.mean).to_equal(2.5);
+      expect(stats.median).to_equal(2.5);
+      expect(stats.min).to_equal(1.0);
+      expect(stats.stddev).to_be_within(0.001).of(1.291);
+      expect(stats.iterations).to_equal(std::uint64_t{10});
+    });
+
+    it("are printed in a suitable unit", _ {
+      auto stats = BenchmarkStats::of({1500, 1500, 1500}, 2);
+      expect(stats.to_string()).to_equal(
+          "mean 1.50 us, median 1.50 us, stddev 0.00 ns, min 1.50 us (3 samples of 2 iterations)");
+    });
+  });
+});
+
+CPPSPEC_MAIN(benchmark_spec);
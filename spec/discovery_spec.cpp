@@ -0,0 +1,134 @@
+#include <string>
+#include <vector>
+
+#include "cppspec.hpp"
+
+using namespace CppSpec;
+
+namespace {
+int body_runs = 0;
+int hook_runs = 0;
+int before_all_runs = 0;
+int block_runs = 0;
+std::vector<std::string> hook_order;
+}  // namespace
+
+// Discovery builds the tree, execution runs it
+describe discovery_spec("Discovery", $ {
+  before_each([] {
+    body_runs = 0;
+    hook_runs = 0;
+    before_all_runs = 0;
+    block_runs = 0;
+    hook_order.clear();
+  });
+
+  it("builds the tree without running any examples or hooks", _ {
+    Description inner("inner", $ {
+      before_all([] { before_all_runs++; });
+      before_each([] { hook_runs++; });
+      it("one", _ { body_runs++; });
+      context("nested", _ {
+        it("two", _ { body_runs++; });
+      });
+    });
+
+    inner.discover();
+    expect(inner.discovered()).to_be_true();
+    expect(inner.num_tests()).to_equal(std::size_t{2});
+    expect(body_runs).to_equal(0);
+    expect(hook_runs).to_equal(0);
+    expect(before_all_runs).to_equal(0);
+  });
+
+  it("runs each example once the tree is executed", _ {
+    Description inner("inner", $ {
+      before_all([] { before_all_runs++; });
+      before_each([] { hook_runs++; });
+      it("one", _ { body_runs++; });
+      context("nested", _ {
+        it("two", _ { body_runs++; });
+      });
+    });
+
+    inner.discover();
+    inner.timed_run();
+    expect(body_runs).to_equal(2);
+    expect(hook_runs).to_equal(2);
+    expect(before_all_runs).to_equal(1);
+  });
+
+  it("only discovers once", _ {
+    Description inner("inner", $ {
+      it("one", _ { body_runs++; });
+    });
+
+    inner.discover();
+    inner.discover();
+    inner.timed_run();
+    expect(inner.num_tests()).to_equal(std::size_t{1});
+    expect(body_runs).to_equal(1);
+  });
+
+  it("applies hooks declared after an example to that example", _ {
+    Description inner("inner", $ {
+      it("one", _ { hook_order.emplace_back("body"); });
+      before_each([] { hook_order.emplace_back("before"); });
+    });
+
+    inner.timed_run();
+    expect(hook_order).to_equal(std::vector<std::string>{"before", "body"});
+  });
+
+  it("runs before_each outermost first and after_each innermost first", _ {
+    Description inner("inner", $ {
+      before_each([] { hook_order.emplace_back("outer before"); });
+      after_each([] { hook_order.emplace_back("outer after"); });
+      context("nested", _ {
+        before_each([] { hook_order.emplace_back("inner before"); });
+        after_each([] { hook_order.emplace_back("inner after"); });
+        it("one", _ { hook_order.emplace_back("body"); });
+      });
+    });
+
+    inner.timed_run();
+    expect(hook_order).to_equal(
+        std::vector<std::string>{"outer before", "inner before", "body", "inner after", "outer after"});
+  });
+
+  it("keeps the locals of a describe block alive while its examples run", _ {
+    Description inner("inner", $ {
+      block_runs++;
+      int n = 0;
+      before_each([&n] { n++; });
+      it("one", [&n](auto&) { body_runs = n; });
+      context("nested", [&n](auto& self) {
+        it("two", [&n](auto&) { hook_runs = n; });
+      });
+    });
+
+    inner.timed_run();
+    expect(inner.get_result().is_success()).to_be_true();
+    expect(block_runs).to_equal(2);
+    expect(body_runs).to_equal(1);
+    expect(hook_runs).to_equal(2);
+  });
+
+  it("reports the examples of a describe block that declares something else when run again", _ {
+    Description inner("inner", $ {
+      if (++block_runs == 1) {
+        it("one", _ { body_runs++; });
+      } else {
+        before_each([] { hook_runs++; });
+      }
+    });
+
+    inner.timed_run();
+    expect(body_runs).to_equal(0);
+    expect(hook_runs).to_equal(0);
+    expect(inner.get_result().is_error()).to_be_true();
+    expect(inner.get_result().get_message()).to_start_with("Not run");
+  });
+});
+
+CPPSPEC_MAIN(discovery_spec);
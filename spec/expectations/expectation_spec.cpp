@@ -1,3 +1,6 @@
+#include <stdexcept>
+#include <string>
+
 #include "cppspec.hpp"
 
 using namespace CppSpec;
@@ -101,6 +104,76 @@ describe expectation_spec("Expectation", $ {
     });
   });
 
+  context("results", _ {
+    it("counts passing expectations instead of keeping them", _ {
+      ItD example(std::source_location::current(), _ {});
+#undef expect
+      for (int i = 0; i < 1000; ++i) {
+        example.expect(i).to_equal(i);
+      }
+      example.expect(1).to_equal(2);
+#define expect self.expect
+      expect(example.get_success_count()).to_equal(std::size_t{1000});
+      expect(example.get_results().size()).to_equal(std::size_t{1});
+      expect(example.num_expectations()).to_equal(std::size_t{1001});
+      expect(example.get_result().is_failure()).to_be_true();
+    });
+
+    it("names the matcher type of a failure", _ {
+      ItD example(std::source_location::current(), _ {});
+#undef expect
+      example.expect(1).to_equal(2);
+#define expect self.expect
+      expect(example.get_results().front().get_type().find("Equal") != std::string::npos).to_be_true();
+    });
+
+    it("demangles each type name only once", _ {
+      const std::string& name = Util::demangle(typeid(CustomMatcher));
+      expect(name).to_equal(std::string("CustomMatcher"));
+      expect(&Util::demangle(typeid(CustomMatcher)) == &name).to_be_true();
+    });
+  });
+
+  context("descriptions", _ {
+    it("describes an example by its first expectation once it's asked", _ {
+      ItD example(std::source_location::current(), _ {});
+#undef expect
+      example.expect(1).to_equal(1);
+      example.expect(2).to_equal(2);
+#define expect self.expect
+      expect(example.needs_description()).to_be_false();
+      expect(example.get_description().starts_with("should equal") && example.get_description().ends_with("1"))
+          .to_be_true();
+    });
+
+    it("describes a negated expectation", _ {
+      ItD example(std::source_location::current(), _ {});
+#undef expect
+      example.expect(1).not_().to_equal(2);
+#define expect self.expect
+      expect(example.get_description().starts_with("should not equal")).to_be_true();
+    });
+
+    it("keeps an explicit description", _ {
+      ItD example(std::source_location::current(), "adds up", _ {});
+#undef expect
+      example.expect(1).to_equal(1);
+#define expect self.expect
+      expect(example.get_description()).to_equal(std::string("adds up"));
+    });
+
+    it("describes a matcher once detached from its expectation, but nothing more", _ {
+      ItD example(std::source_location::current(), _ {});
+#undef expect
+      auto expectation = example.expect(5);
+#define expect self.expect
+      Matchers::BeBetween<int, int> matcher(expectation, 1, 10);
+      matcher.detach();
+      expect(matcher.description()).to_equal(std::string("be between 1 and 10 (inclusive)"));
+      expect([&]() -> int { return matcher.actual(); }).template to_throw<std::logic_error>();
+    });
+  });
+
   context("ExpectationFunc", _ {
 	it("is lazy", _{
 	  // MSVCC optimizes this away into an int, when
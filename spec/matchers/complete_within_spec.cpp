@@ -0,0 +1,106 @@
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+using namespace std::chrono_literals;
+
+namespace {
+int calls = 0;
+
+// The message of the first result of the only example in `spec`
+std::string message_of(Description& spec) {
+  SpecHelper::run_specs({spec});
+  return dynamic_cast<ItBase*>(spec.get_children().front())->get_results().front().get_message();
+}
+}  // namespace
+
+describe complete_within_spec("expect(block).to_complete_within(limit)", $ {
+  before_each([] { calls = 0; });
+
+  it("passes when the block runs within the limit", _ {
+    std::function<int()> f = [] { return ++calls; };
+    expect(f).to_complete_within(1s);
+    expect(calls).to_equal(1);
+  });
+
+  it("passes not_() when the block takes longer than the limit", _ {
+    std::function<int()> f = [] {
+      std::this_thread::sleep_for(5ms);
+      return 0;
+    };
+    expect(f).not_().to_complete_within(1ms);
+  });
+
+  it("fails with the time the block took", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it(_ {
+        std::function<int()> f = [] {
+          std::this_thread::sleep_for(5ms);
+          return 0;
+        };
+        expect(f).to_complete_within(1ms);
+      });
+    });
+    // clang-format on
+    std::string message = message_of(spec);
+    expect(message).to_start_with(
+        "expected the given function ([] -> int {...}) to complete within 1.00 ms, but it took");
+    expect(spec.get_result().is_failure()).to_be_true();
+  });
+
+  context("over a number of runs", _ {
+    it("runs the block that many times", _ {
+      std::function<int()> f = [] { return ++calls; };
+      expect(f).over(100).runs().to_complete_within(1s);
+      expect(calls).to_equal(100);
+    });
+
+    it("compares the given percentile, ignoring slower outliers", _ {
+      std::function<int()> f = [] {
+        if (++calls == 1) {
+          std::this_thread::sleep_for(20ms);
+        }
+        return calls;
+      };
+      expect(f).over(100).runs().at_p90().to_complete_within(10ms);
+    });
+
+    it("compares the slowest run when no percentile is given", _ {
+      std::function<int()> f = [] {
+        if (++calls == 1) {
+          std::this_thread::sleep_for(20ms);
+        }
+        return calls;
+      };
+      expect(f).over(10).runs().not_().to_complete_within(10ms);
+    });
+
+    it("fails with the distribution of the times the block took", _ {
+      // clang-format off
+      Description spec("spec", $ {
+        it(_ {
+          std::function<int()> f = [] {
+            std::this_thread::sleep_for(2ms);
+            return 0;
+          };
+          expect(f).over(10).runs().at_p99().to_complete_within(1ms);
+        });
+      });
+      // clang-format on
+      std::string message = message_of(spec);
+      expect(message.find("to complete within 1.00 ms at p99 over 10 runs, but it took") != std::string::npos)
+          .to_be_true();
+      expect(message.find("(min ") != std::string::npos).to_be_true();
+      expect(message.find(", p50 ") != std::string::npos).to_be_true();
+      expect(message.find(", max ") != std::string::npos).to_be_true();
+    });
+  });
+});
+
+CPPSPEC_MAIN(complete_within_spec);
@@ -1,11 +1,32 @@
 #include <list>
+#include <numeric>
+#include <ostream>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "cppspec.hpp"
 
 using namespace CppSpec;
 
+namespace {
+// Ordered, but not hashable
+struct Version {
+  int major;
+  auto operator<=>(const Version&) const = default;
+  friend std::ostream& operator<<(std::ostream& os, const Version& version) { return os << 'v' << version.major; }
+};
+
+struct Counted {
+  static inline int copies = 0;
+  Counted() = default;
+  Counted(const Counted& /*other*/) { ++copies; }
+  Counted& operator=(const Counted&) = default;
+  bool operator==(const Counted& /*other*/) const { return true; }
+  friend std::ostream& operator<<(std::ostream& os, const Counted& /*counted*/) { return os << "counted"; }
+};
+}  // namespace
+
 describe contain_spec("to_contain matcher", $ {
   context("with a single element", _ {
     it("passes when element is in vector", _ {
@@ -80,6 +101,51 @@ describe contain_spec("to_contain matcher", $ {
       expect(std::vector<std::string>{"foo", "bar"}).not_().to_contain(std::string{"quux"});
     });
   });
+
+  context("with many elements", _ {
+    it("finds them all in a large container", _ {
+      std::vector<int> numbers(10000);
+      std::iota(numbers.begin(), numbers.end(), 0);
+      expect(numbers).to_contain({0, 1, 2, 3, 5, 8, 13, 21, 34, 55, 89, 144, 233, 377, 610, 987, 1597, 2584, 4181, 6765});
+      expect(numbers).not_().to_contain({-1, -2, -3, -4, -5, -6, -7, -8, -9, -10, -11, -12, -13, -14, -15, -16});
+    });
+
+    it("finds strings", _ {
+      std::vector<std::string> words{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p"};
+      expect(words).to_contain({"p", "o", "n", "m", "l", "k", "j", "i", "h", "g", "f", "e", "d", "c", "b", "a"});
+    });
+
+    it("finds elements that can only be ordered", _ {
+      std::vector<Version> versions;
+      for (int major = 0; major < 20; ++major) {
+        versions.push_back({major});
+      }
+      std::vector<Version> wanted(versions.rbegin(), versions.rend());
+      ItD example(std::source_location::current(), _ {});
+#undef expect
+      example.expect(versions).to_contain({wanted[0], wanted[1], wanted[2], wanted[3], wanted[4], wanted[5], wanted[6],
+                                           wanted[7], wanted[8], wanted[9], wanted[10], wanted[11], wanted[12],
+                                           wanted[13], wanted[14], wanted[15], wanted[16]});
+#define expect self.expect
+      expect(example.get_result().is_success()).to_be_true();
+    });
+
+    it("fails a negated match if any of the items is there", _ {
+      ItD example(std::source_location::current(), _ {});
+#undef expect
+      example.expect(std::vector<int>{1, 2, 3}).not_().to_contain({7, 2});
+#define expect self.expect
+      expect(example.get_result().is_failure()).to_be_true();
+    });
+
+    it("doesn't copy the container", _ {
+      std::vector<Counted> items(100);
+      auto expectation = expect(items);
+      int copies = Counted::copies;
+      expectation.to_contain(Counted{});
+      expect(Counted::copies - copies < 10).to_be_true();
+    });
+  });
 });
 
 CPPSPEC_MAIN(contain_spec);
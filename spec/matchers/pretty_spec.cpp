@@ -0,0 +1,88 @@
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "cppspec.hpp"
+
+using namespace CppSpec;
+
+namespace {
+// Leaves the stream it's printed to in hex
+struct Hex {
+  int value;
+  friend std::ostream& operator<<(std::ostream& os, const Hex& hex) { return os << std::hex << hex.value; }
+};
+
+// Pretty-prints its contents from within operator<<
+struct Box {
+  std::vector<int> items;
+  friend std::ostream& operator<<(std::ostream& os, const Box& box) {
+    return os << "Box(" << Pretty::to_word(box.items) << ")";
+  }
+};
+}  // namespace
+
+// clang-format off
+describe pretty_spec("Pretty", $ {
+  context(".to_word", _ {
+    it("formats numbers like a stream does", _ {
+      expect(Pretty::to_word(42)).to_equal(std::string("42"));
+      expect(Pretty::to_word(-7L)).to_equal(std::string("-7"));
+      expect(Pretty::to_word(1.0 / 3)).to_equal(std::string("0.333333"));
+      expect(Pretty::to_word(1e20)).to_equal(std::string("1e+20"));
+      expect(Pretty::to_word(2.5f)).to_equal(std::string("2.5"));
+    });
+
+    it("formats characters and booleans as such", _ {
+      expect(Pretty::to_word('a')).to_equal(std::string("a"));
+      expect(Pretty::to_word(true)).to_equal(std::string("true"));
+    });
+
+    it("formats containers", _ {
+      expect(Pretty::to_word(std::vector<int>{1, 2, 3})).to_equal(std::string("[1, 2, 3]"));
+    });
+
+    it("isn't affected by an operator<< that changes the stream", _ {
+      expect(Pretty::to_word(Hex{255})).to_equal(std::string("ff"));
+      expect(Pretty::to_word(std::vector<int>{255})).to_equal(std::string("[255]"));
+    });
+
+    it("can be used from within operator<<", _ {
+      expect(Pretty::to_word(Box{{1, 2}})).to_equal(std::string("Box([1, 2])"));
+    });
+  });
+
+  context(".to_sentence", _ {
+    it("lists one, two or more items", _ {
+      expect(Pretty::to_sentence(1)).to_equal(std::string(" 1"));
+      expect(Pretty::to_sentence(std::vector<int>{1, 2})).to_equal(std::string(" 1 and 2"));
+      expect(Pretty::to_sentence(std::vector<int>{1, 2, 3})).to_equal(std::string(" 1, 2, and 3"));
+      expect(Pretty::to_sentence({4, 5})).to_equal(std::string(" 4 and 5"));
+    });
+  });
+
+  context("string helpers", _ {
+    it("splits words at underscores", _ {
+      expect(Pretty::split_words("be_greater_than")).to_equal(std::string("be greater than"));
+    });
+
+    it("underscores camel case and dashes", _ {
+      expect(Pretty::underscore("HTTPServerError")).to_equal(std::string("http_server_error"));
+      expect(Pretty::underscore("camelCase2Go")).to_equal(std::string("camel_case2_go"));
+      expect(Pretty::underscore("dashed-word")).to_equal(std::string("dashed_word"));
+    });
+
+    it("takes the last part of a qualified name", _ {
+      expect(Pretty::last("CppSpec::Matchers::Equal", ':')).to_equal(std::string("Equal"));
+      expect(Pretty::last("Equal", ':')).to_equal(std::string("Equal"));
+    });
+
+    it("spaces out hash arrows", _ {
+      expect(Pretty::improve_hash_formatting("{a=>1, b=>2}")).to_equal(std::string("{a => 1, b => 2}"));
+      expect(Pretty::improve_hash_formatting("a => 1")).to_equal(std::string("a => 1"));
+    });
+  });
+});
+
+CPPSPEC_MAIN(pretty_spec);
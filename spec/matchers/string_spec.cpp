@@ -103,6 +103,50 @@ describe string_spec("string matchers", $ {
     it("matches case-insensitively with flag", _ {
       expect(std::string{"HELLO"}).to_match(std::regex("hello", std::regex::icase));
     });
+
+    it("matches a pattern known at compile time", _ {
+      expect(std::string{"hello"}).template to_match<"h[a-z]+">();
+      expect(std::string{"hello"}).not_().template to_match<"h[0-9]+">();
+    });
+  });
+
+  context("Pattern", _ {
+    using Matchers::Pattern;
+
+    it("compares literals as strings", _ {
+      Pattern pattern("a\\.b");
+      expect(pattern.kind() == Pattern::Kind::Literal).to_be_true();
+      expect(pattern.matches("a.b")).to_be_true();
+      expect(pattern.matches("axb")).to_be_false();
+      expect(Pattern("^hello$").matches("hello")).to_be_true();
+    });
+
+    it("compares a literal followed by .* as a prefix", _ {
+      Pattern pattern("^hel.*");
+      expect(pattern.kind() == Pattern::Kind::Prefix).to_be_true();
+      expect(pattern.matches("hello")).to_be_true();
+      expect(pattern.matches("help")).to_be_true();
+      expect(pattern.matches("hi")).to_be_false();
+      expect(pattern.matches("hel\nlo")).to_be_false();
+    });
+
+    it("compiles anything else", _ {
+      expect(Pattern("[0-9]+").kind() == Pattern::Kind::Regex).to_be_true();
+      expect(Pattern("a\\d").kind() == Pattern::Kind::Regex).to_be_true();
+      expect(Pattern("hel\\.*").kind() == Pattern::Kind::Regex).to_be_true();
+      expect(Pattern("hello", std::regex::icase).kind() == Pattern::Kind::Regex).to_be_true();
+      expect(Pattern("hello", std::regex::icase).matches("HELLO")).to_be_true();
+    });
+
+    it("compiles each pattern once", _ {
+      auto first = Pattern::compile("[a-z]+[0-9]+", std::regex::ECMAScript);
+      expect(Pattern::compile("[a-z]+[0-9]+", std::regex::ECMAScript) == first).to_be_true();
+      expect(Pattern::compile("[a-z]+[0-9]+", std::regex::icase) == first).to_be_false();
+    });
+
+    it("is shown as the pattern it was given", _ {
+      expect(Pretty::to_word(Pattern("h.*o"))).to_equal(std::string("/h.*o/"));
+    });
   });
 
   context("string to_contain (char)", _ {
@@ -2,6 +2,7 @@
 #include <stdexcept>
 
 #include "cppspec.hpp"
+#include "spec_helper.hpp"
 
 using namespace CppSpec;
 
@@ -43,8 +44,18 @@ describe throw_spec("to_throw matcher", $ {
     });
 
     it("does not catch wrong exception type", _ {
-      std::function<void*()> f = [] -> void* { throw OtherException{}; };
-      expect(f).not_().template to_throw<MyException>();
+      // The exception escapes the matcher, so the example errors
+      // clang-format off
+      Description spec("spec", $ {
+        it("throws something else", _ {
+          std::function<void*()> f = [] -> void* { throw OtherException{}; };
+          expect(f).not_().template to_throw<MyException>();
+        });
+      });
+      // clang-format on
+      SpecHelper::run_specs({spec});
+      expect(spec.get_result().is_error()).to_be_true();
+      expect(spec.get_result().get_message()).to_equal("OtherException");
     });
 
     it("catches std::runtime_error specifically", _ {
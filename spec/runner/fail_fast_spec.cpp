@@ -0,0 +1,94 @@
+#include <atomic>
+#include <string>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+namespace {
+std::atomic<int> examples_run = 0;
+int after_all_runs = 0;
+
+struct Outcome {
+  std::size_t reported;
+  std::size_t failures;
+  std::string output;
+};
+
+Outcome run_with_fail_fast(std::size_t max_failures, std::size_t jobs = 1) {
+  // clang-format off
+  Description first("first", $ {
+    it("passes", _ { examples_run++; expect(1).to_equal(1); });
+    it("fails", _ { examples_run++; expect(1).to_equal(2); });
+    it("fails again", _ { examples_run++; expect(1).to_equal(3); });
+    context("later", _ {
+      after_all([] { after_all_runs++; });
+      it("passes", _ { examples_run++; });
+    });
+  });
+  Description second("second", $ {
+    it("passes", _ { examples_run++; });
+  });
+  // clang-format on
+
+  auto run = SpecHelper::run_specs({first, second}, [=](Runner& runner) {
+    runner.set_fail_fast(max_failures).set_jobs(jobs);
+  });
+  return {
+      .reported = first.num_tests() + second.num_tests(),
+      .failures = first.num_failures() + second.num_failures(),
+      .output = run.output,
+  };
+}
+}  // namespace
+
+describe fail_fast_spec("Runner --fail-fast", $ {
+  before_each([] {
+    examples_run = 0;
+    after_all_runs = 0;
+  });
+
+  it("stops starting examples after the first failure", _ {
+    Outcome outcome = run_with_fail_fast(1);
+    expect(examples_run.load()).to_equal(2);
+    expect(outcome.failures).to_equal(std::size_t{1});
+  });
+
+  it("allows a configurable number of failures", _ {
+    Outcome outcome = run_with_fail_fast(2);
+    expect(examples_run.load()).to_equal(3);
+    expect(outcome.failures).to_equal(std::size_t{2});
+  });
+
+  it("skips the hooks of contexts that never started", _ {
+    run_with_fail_fast(1);
+    expect(after_all_runs).to_equal(0);
+  });
+
+  it("only reports the examples that ran", _ {
+    Outcome outcome = run_with_fail_fast(1);
+    expect(outcome.reported).to_equal(std::size_t{2});
+    expect(outcome.output.find("second")).to_equal(std::string::npos);
+  });
+
+  it("runs everything when the threshold isn't reached", _ {
+    Outcome outcome = run_with_fail_fast(3);
+    expect(examples_run.load()).to_equal(5);
+    expect(outcome.reported).to_equal(std::size_t{5});
+  });
+
+  it("runs everything when disabled", _ {
+    run_with_fail_fast(0);
+    expect(examples_run.load()).to_equal(5);
+    expect(after_all_runs).to_equal(1);
+  });
+
+  it("stops a parallel run too", _ {
+    Outcome outcome = run_with_fail_fast(1, 4);
+    expect(outcome.failures).to_be_greater_than(std::size_t{0});
+    expect(outcome.reported).to_equal(static_cast<std::size_t>(examples_run.load()));
+  });
+});
+
+CPPSPEC_MAIN(fail_fast_spec);
@@ -0,0 +1,129 @@
+#include <format>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+namespace {
+std::vector<std::string> ran;
+int before_each_runs = 0;
+int before_all_runs = 0;
+
+// Run a fresh copy of the spec with whatever filters `configure` adds
+void run_filtered(const std::function<void(Runner&, Description&)>& configure) {
+  // clang-format off
+  Description spec("filtering", $ {
+    before_each([] { before_each_runs++; });
+    it("finds a needle", _ { ran.emplace_back("needle"); });
+    it("finds a haystack", _ { ran.emplace_back("haystack"); });
+    context("elsewhere", _ {
+      before_all([] { before_all_runs++; });
+      it("finds nothing", _ { ran.emplace_back("nothing"); });
+      it("finds more nothing", _ { ran.emplace_back("more nothing"); });
+    });
+  });
+  // clang-format on
+
+  spec.discover();  // So that `configure` can look at the tree
+  SpecHelper::run_specs({spec}, [&](Runner& runner) { configure(runner, spec); });
+}
+}  // namespace
+
+describe filter_spec("Runner --example/--location", $ {
+  before_each([] {
+    ran.clear();
+    before_each_runs = 0;
+    before_all_runs = 0;
+  });
+
+  context("--example", _ {
+    it("only runs examples whose description matches", _ {
+      run_filtered([](Runner& runner, Description&) { runner.add_example_filter("needle"); });
+      expect(ran.size()).to_equal(std::size_t{1});
+      expect(ran.front()).to_equal("needle");
+    });
+
+    it("skips the hooks of examples that don't match", _ {
+      run_filtered([](Runner& runner, Description&) { runner.add_example_filter("needle"); });
+      expect(before_each_runs).to_equal(1);
+      expect(before_all_runs).to_equal(0);
+    });
+
+    it("matches against the descriptions of enclosing contexts", _ {
+      run_filtered([](Runner& runner, Description&) { runner.add_example_filter("^elsewhere finds"); });
+      expect(ran.size()).to_equal(std::size_t{2});
+      expect(before_all_runs).to_equal(1);
+    });
+
+    it("runs examples matching any of several patterns", _ {
+      run_filtered([](Runner& runner, Description&) {
+        runner.add_example_filter("needle").add_example_filter("more");
+      });
+      expect(ran.size()).to_equal(std::size_t{2});
+    });
+
+    it("runs nothing when nothing matches", _ {
+      run_filtered([](Runner& runner, Description&) { runner.add_example_filter("unicorn"); });
+      expect(ran.empty()).to_be_true();
+      expect(before_each_runs).to_equal(0);
+    });
+
+    it("matches an unnamed example by its FILE:LINE", _ {
+      // clang-format off
+      Description spec("unnamed", $ {
+        it(_ { ran.emplace_back("unnamed"); });
+        it("is named", _ { ran.emplace_back("named"); });
+      });
+      // clang-format on
+      spec.discover();
+      auto line = spec.get_children().front()->get_location().line();
+      SpecHelper::run_specs({spec}, [line](Runner& runner) {
+        runner.add_example_filter(std::format(R"(filter_spec\.cpp:{}$)", line));
+      });
+      expect(ran).to_equal(std::vector<std::string>{"unnamed"});
+    });
+  });
+
+  context("--location", _ {
+    it("runs the example declared on that line", _ {
+      run_filtered([](Runner& runner, Description& spec) {
+        auto location = spec.get_children().front()->get_location();
+        runner.add_location_filter(file_name(location.file_name()), location.line());
+      });
+      expect(ran.size()).to_equal(std::size_t{1});
+      expect(ran.front()).to_equal("needle");
+    });
+
+    it("runs every example in a context declared on that line", _ {
+      run_filtered([](Runner& runner, Description& spec) {
+        auto location = spec.get_children().back()->get_location();
+        runner.add_location_filter(file_name(location.file_name()), location.line());
+      });
+      expect(ran.size()).to_equal(std::size_t{2});
+      expect(before_all_runs).to_equal(1);
+    });
+
+    it("only matches whole file names", _ {
+      run_filtered([](Runner& runner, Description& spec) {
+        auto location = spec.get_children().front()->get_location();
+        runner.add_location_filter("ter_spec.cpp", location.line());
+      });
+      expect(ran.empty()).to_be_true();
+    });
+
+    it("parses FILE:LINE", _ {
+      auto [file, line] = parse_location("spec/a_spec.cpp:12");
+      expect(file).to_equal("spec/a_spec.cpp");
+      expect(line).to_equal(std::uint_least32_t{12});
+      expect([] { return parse_location("a_spec.cpp").second; }).template to_throw<std::invalid_argument>();
+      expect([] { return parse_location("a_spec.cpp:twelve").second; }).template to_throw<std::invalid_argument>();
+    });
+  });
+});
+
+CPPSPEC_MAIN(filter_spec);
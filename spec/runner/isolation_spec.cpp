@@ -0,0 +1,106 @@
+#include <cstdlib>
+#include <string>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+#ifdef _WIN32
+// Isolation needs fork(), so it isn't available on Windows
+describe isolation_spec("Runner --isolate", $ {});
+#else
+namespace {
+int in_process_runs = 0;
+
+struct Outcome {
+  Result crashed;
+  Result passing;
+  Result failing;
+  std::string failure_message;
+  std::string generated_description;
+  std::string output;
+  bool success;
+};
+
+Outcome run_isolated(std::size_t jobs) {
+  // clang-format off
+  Description crashes("crashes", $ {
+    it("aborts", _ { std::abort(); });
+  });
+  Description passes("passes", $ {
+    it("runs in another process", _ {
+      in_process_runs++;
+      expect(1).to_equal(1);
+    });
+    it(_ { expect(2).to_equal(2); });
+  });
+  Description fails("fails", $ {
+    it("keeps its failure message", _ { expect(1).to_equal(2); });
+  });
+  // clang-format on
+
+  auto run = SpecHelper::run_specs({crashes, passes, fails}, [=](Runner& runner) {
+    runner.set_jobs(jobs).set_isolated(true);
+  });
+
+  auto& failing_it = static_cast<ItBase&>(*fails.get_children().front());
+  auto& anonymous_it = static_cast<ItBase&>(*passes.get_children().back());
+  return {
+      .crashed = crashes.get_result(),
+      .passing = passes.get_result(),
+      .failing = fails.get_result(),
+      .failure_message = failing_it.get_results().front().get_message(),
+      .generated_description = anonymous_it.get_description(),
+      .output = run.output,
+      .success = run.success,
+  };
+}
+}  // namespace
+
+describe isolation_spec("Runner --isolate", $ {
+  before_each([] { in_process_runs = 0; });
+
+  it("reports a crashing spec as an error", _ {
+    Outcome outcome = run_isolated(1);
+    expect(outcome.crashed.is_error()).to_be_true();
+    expect(outcome.success).to_be_false();
+  });
+
+  it("fails a run whose only problem is a crash", _ {
+    // clang-format off
+    Description crashes("crashes", $ {
+      it("aborts", _ { std::abort(); });
+    });
+    Description passes("passes", $ {
+      it("passes", _ { expect(1).to_equal(1); });
+    });
+    // clang-format on
+    auto run = SpecHelper::run_specs({crashes, passes}, [](Runner& runner) { runner.set_isolated(true); });
+    expect(run.success).to_be_false();
+  });
+
+  it("keeps running the other specs", _ {
+    Outcome outcome = run_isolated(2);
+    expect(outcome.passing.is_success()).to_be_true();
+    expect(outcome.failing.is_failure()).to_be_true();
+  });
+
+  it("runs specs in child processes", _ {
+    run_isolated(2);
+    expect(in_process_runs).to_equal(0);
+  });
+
+  it("sends back failure messages and generated descriptions", _ {
+    Outcome outcome = run_isolated(2);
+    expect(outcome.failure_message.empty()).to_be_false();
+    expect(outcome.generated_description.empty()).to_be_false();
+  });
+
+  it("reports the same output no matter how many processes run", _ {
+    expect(run_isolated(3).output).to_equal(run_isolated(1).output);
+  });
+});
+#endif
+
+CPPSPEC_MAIN(isolation_spec);
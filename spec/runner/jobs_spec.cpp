@@ -0,0 +1,82 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+namespace {
+std::atomic<bool> wait_for_others = false;
+std::atomic<int> arrived = 0;
+std::atomic<int> saw_everyone = 0;
+
+// Wait (briefly) for the other specs to start too. This only succeeds
+// when the specs are actually running at the same time.
+void rendezvous() {
+  if (!wait_for_others) {
+    return;
+  }
+  arrived++;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (arrived < 4 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  if (arrived >= 4) {
+    saw_everyone++;
+  }
+}
+
+std::string run_with_jobs(std::size_t jobs) {
+  // clang-format off
+  Description first("first", $ {
+    it("waits for the others", _ { rendezvous(); });
+    it("passes", _ { expect(1).to_equal(1); });
+  });
+  Description second("second", $ {
+    it("waits for the others", _ { rendezvous(); });
+    it("fails", _ { expect(1).to_equal(2); });
+  });
+  Description third("third", $ {
+    it("waits for the others", _ { rendezvous(); });
+  });
+  Description fourth("fourth", $ {
+    context("nested", _ {
+      it("waits for the others", _ { rendezvous(); });
+    });
+  });
+  // clang-format on
+
+  return SpecHelper::run_specs({first, second, third, fourth}, [=](Runner& runner) { runner.set_jobs(jobs); }).output;
+}
+}  // namespace
+
+describe jobs_spec("Runner --jobs", $ {
+  before_each([] {
+    wait_for_others = false;
+    arrived = 0;
+    saw_everyone = 0;
+  });
+
+  it("runs top-level specs concurrently", _ {
+    wait_for_others = true;
+    run_with_jobs(4);
+    expect(saw_everyone.load()).to_equal(4);
+  });
+
+  it("reports specs in declaration order, the same as a serial run", _ {
+    std::string serial = run_with_jobs(1);
+    std::string parallel = run_with_jobs(4);
+    expect(parallel).to_equal(serial);
+  });
+
+  it("treats 0 as one job per hardware thread", _ {
+    Runner runner;
+    runner.set_jobs(0);
+    expect(runner.get_jobs()).to_be_greater_than(std::size_t{0});
+  });
+});
+
+CPPSPEC_MAIN(jobs_spec);
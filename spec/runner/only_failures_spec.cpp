@@ -0,0 +1,99 @@
+#include <cstdio>
+#include <filesystem>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+namespace {
+std::set<std::string> ran;
+bool fixed = false;  // Whether "is broken" passes
+const std::string failures_file = (std::filesystem::temp_directory_path() / "cppspec_only_failures_spec").string();
+
+// Run a fresh copy of the spec, recording failures in `failures_file`
+void run_spec(bool only_failures) {
+  // clang-format off
+  Description spec("spec", $ {
+    it("passes", _ { ran.insert("passes"); });
+    it("is broken", _ {
+      ran.insert("is broken");
+      expect(fixed).to_be_true();
+    });
+    context("nested", _ {
+      it("throws", _ {
+        ran.insert("throws");
+        expect([] -> int { throw std::runtime_error{"boom"}; }).to_equal(1);
+      });
+      it("passes", _ { ran.insert("nested passes"); });
+    });
+  });
+  // clang-format on
+
+  SpecHelper::run_specs({spec}, [=](Runner& runner) {
+    runner.set_failures_file(failures_file).set_only_failures(only_failures);
+  });
+}
+}  // namespace
+
+describe only_failures_spec("Runner --only-failures", $ {
+  before_each([] {
+    std::remove(failures_file.c_str());
+    ran.clear();
+    fixed = false;
+  });
+
+  it("records the examples that failed or errored", _ {
+    run_spec(false);
+    auto failed = Runner::read_failures(failures_file);
+    expect(failed.has_value()).to_be_true();
+    expect(failed->size()).to_equal(std::size_t{2});
+  });
+
+  it("only runs the examples that failed last time", _ {
+    run_spec(false);
+    ran.clear();
+    run_spec(true);
+    expect(ran).to_equal(std::set<std::string>{"is broken", "throws"});
+  });
+
+  it("forgets examples once they pass", _ {
+    run_spec(false);
+    fixed = true;
+    run_spec(true);
+    ran.clear();
+    run_spec(true);
+    expect(ran).to_equal(std::set<std::string>{"throws"});
+  });
+
+  it("keeps the status of examples that didn't run", _ {
+    run_spec(false);
+    run_spec(true);
+    expect(Runner::read_failures(failures_file)->size()).to_equal(std::size_t{2});
+  });
+
+  it("runs everything when nothing has been recorded yet", _ {
+    run_spec(true);
+    expect(ran.size()).to_equal(std::size_t{4});
+  });
+
+  it("identifies examples by their location and descriptions", _ {
+    // clang-format off
+    Description spec("outer", $ {
+      context("inner", _ {
+        it("does a thing", _ {});
+      });
+    });
+    // clang-format on
+    spec.discover();
+    const auto& inner = *spec.get_children().front();
+    const auto& example = static_cast<const ItBase&>(*inner.get_children().front());
+    expect(Runner::example_id(example)).to_end_with(" outer inner does a thing");
+    expect(Runner::example_id(example)).to_start_with(example.get_location().file_name());
+  });
+});
+
+CPPSPEC_MAIN(only_failures_spec);
@@ -0,0 +1,160 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+#ifdef _WIN32
+// The orchestrator needs fork(), so it isn't available on Windows
+describe orchestrator_spec("cppspec-run", $ {});
+#else
+#include "orchestrator.hpp"
+
+namespace {
+namespace fs = std::filesystem;
+using Formatters::ReportNodes::Suite;
+
+// Examples that this binary runs in another copy of itself, when asked to
+bool is_child() {
+  return std::getenv("CPPSPEC_ORCHESTRATOR_SPEC") != nullptr;
+}
+
+std::vector<Suite> report_of(Description& spec) {
+  std::ostringstream report;
+  SpecHelper::run_with(std::make_shared<Formatters::Report>(report), {spec});
+  std::vector<Suite> suites;
+  Formatters::ReportNodes::read(report.str(), suites);
+  return suites;
+}
+
+// Run copies of this binary, each with the arguments given for it
+std::vector<Orchestrator::Binary> run_self(const std::vector<std::vector<std::string>>& runs) {
+  std::vector<Orchestrator::Binary> binaries;
+  ::setenv("CPPSPEC_ORCHESTRATOR_SPEC", "1", 1);
+  for (const auto& args : runs) {
+    std::vector<Orchestrator::Binary> binary{{.path = fs::read_symlink("/proc/self/exe")}};
+    Orchestrator::run(binary, 1, args, [](const Orchestrator::Binary&) {});
+    binaries.push_back(std::move(binary.front()));
+  }
+  ::unsetenv("CPPSPEC_ORCHESTRATOR_SPEC");
+  return binaries;
+}
+
+void touch(const fs::path& path, fs::perms perms) {
+  fs::create_directories(path.parent_path());
+  std::ofstream{path} << "#!/bin/sh\n";
+  fs::permissions(path, perms);
+}
+}  // namespace
+
+describe orchestrator_spec("cppspec-run", $ {
+  context("a report", _ {
+    it("keeps every example's description, location and results", _ {
+      // clang-format off
+      Description spec("spec", $ {
+        it("passes", _ { expect(1).to_equal(1); });
+        context("nested", _ {
+          it("fails", _ { expect(1).to_equal(2); });
+        });
+      });
+      // clang-format on
+      auto suites = report_of(spec);
+      expect(suites.size()).to_equal(std::size_t{1});
+      expect(suites.front().name).to_equal("spec");
+      expect(suites.front().examples.size()).to_equal(std::size_t{2});
+
+      const auto& failing = suites.front().examples.back();
+      expect(failing.description).to_equal("nested fails");
+      expect(failing.file).to_end_with("orchestrator_spec.cpp");
+      expect(failing.status() == Result::Status::Failure).to_be_true();
+      expect(failing.results.front().message.empty()).to_be_false();
+    });
+
+    it("is only read as far as it's complete", _ {
+      // clang-format off
+      Description spec("spec", $ {
+        it("passes", _ {});
+      });
+      // clang-format on
+      std::ostringstream report;
+      SpecHelper::run_with(std::make_shared<Formatters::Report>(report), {spec});
+      std::string truncated = report.str().substr(0, report.str().size() - 1);
+      std::vector<Suite> suites;
+      expect(Formatters::ReportNodes::read(truncated, suites)).to_be_false();
+    });
+  });
+
+  it("finds the executables named *_spec in a directory", _ {
+    fs::path dir = fs::temp_directory_path() / "cppspec_orchestrator_spec";
+    fs::remove_all(dir);
+    touch(dir / "b_spec", fs::perms::owner_all);
+    touch(dir / "nested" / "a_spec", fs::perms::owner_all);
+    touch(dir / "not_executable_spec", fs::perms::owner_read | fs::perms::owner_write);
+    touch(dir / "a_tool", fs::perms::owner_all);
+
+    auto found = Orchestrator::find_spec_binaries({dir});
+    fs::remove_all(dir);
+    expect(found).to_equal(std::vector<fs::path>{dir / "b_spec", dir / "nested" / "a_spec"});
+  });
+
+#ifdef __linux__
+  context("fixtures", _ {
+    it("passes", _ {});
+    it("fails in a child", _ { expect(is_child()).to_be_false(); });
+    it("crashes in a child", _ {
+      if (is_child()) {
+        std::abort();
+      }
+    });
+  });
+
+  context("running binaries", _ {
+    it("merges the reports of every binary", _ {
+      auto binaries = run_self({{"-e", "fixtures passes"}, {"-e", "fixtures fails"}});
+      expect(binaries[0].suites.front().examples.size()).to_equal(std::size_t{1});
+      expect(Orchestrator::succeeded({binaries[0]})).to_be_true();
+      expect(Orchestrator::succeeded(binaries)).to_be_false();
+
+      auto junit = Orchestrator::to_junit(binaries, "merged");
+      expect(junit.suites.size()).to_equal(std::size_t{2});
+      expect(junit.tests).to_equal(std::size_t{2});
+      expect(junit.failures).to_equal(std::size_t{1});
+    });
+
+    it("reports a binary that crashes as an error", _ {
+      auto binaries = run_self({{"-e", "fixtures crashes"}});
+      const auto& example = binaries.front().suites.back().examples.front();
+      expect(example.status() == Result::Status::Error).to_be_true();
+      expect(example.results.front().message).to_start_with("Spec process was killed by signal");
+    });
+
+    it("reports a binary that can't be run as an error", _ {
+      std::vector<Orchestrator::Binary> binaries{{.path = "/nonexistent/cppspec_spec"}};
+      Orchestrator::run(binaries, 1, {}, [](const Orchestrator::Binary&) {});
+      expect(binaries.front().suites.front().examples.front().results.front().message).to_start_with("Could not run");
+    });
+
+    it("shows one progress display for every binary", _ {
+      auto binaries = run_self({{"-e", "fixtures passes"}, {"-e", "fixtures fails"}});
+      std::ostringstream out;
+      Orchestrator::ProgressDisplay display{out, false};
+      for (const auto& binary : binaries) {
+        display.format(binary);
+      }
+      display.summarize(binaries.size(), {});
+      expect(out.str()).to_start_with(".F\n");
+      expect(out.str().find("2 examples, 1 failures, 0 errors in 2 spec binaries") != std::string::npos)
+          .to_be_true();
+    });
+  });
+#endif
+});
+#endif
+
+CPPSPEC_MAIN(orchestrator_spec);
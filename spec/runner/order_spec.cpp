@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+namespace {
+std::vector<std::string> order;
+
+std::vector<std::string> run_in_order(std::optional<std::uint64_t> seed) {
+  order.clear();
+  // clang-format off
+  Description first("first", $ {
+    it("a", _ { order.emplace_back("a"); });
+    it("b", _ { order.emplace_back("b"); });
+    it("c", _ { order.emplace_back("c"); });
+    context("nested", _ {
+      it("d", _ { order.emplace_back("d"); });
+      it("e", _ { order.emplace_back("e"); });
+      it("f", _ { order.emplace_back("f"); });
+    });
+  });
+  Description second("second", $ {
+    it("g", _ { order.emplace_back("g"); });
+    it("h", _ { order.emplace_back("h"); });
+  });
+  // clang-format on
+
+  SpecHelper::run_specs({first, second}, [=](Runner& runner) {
+    if (seed) {
+      runner.set_random_order(*seed);
+    }
+  });
+  return order;
+}
+
+std::string joined(const std::vector<std::string>& strings) {
+  return Util::join(strings);
+}
+}  // namespace
+
+describe order_spec("Runner --order", $ {
+  it("runs examples in the order they're defined by default", _ {
+    expect(joined(run_in_order(std::nullopt))).to_equal("abcdefgh");
+  });
+
+  it("replays the same order for the same seed", _ {
+    expect(joined(run_in_order(1234))).to_equal(joined(run_in_order(1234)));
+  });
+
+  it("shuffles examples with a seed", _ {
+    expect(joined(run_in_order(1))).not_().to_equal(joined(run_in_order(2)));
+  });
+
+  it("still runs every example exactly once", _ {
+    std::vector<std::string> shuffled = run_in_order(42);
+    std::ranges::sort(shuffled);
+    expect(joined(shuffled)).to_equal("abcdefgh");
+  });
+
+  it("parses --order", _ {
+    expect(parse_order("defined").has_value()).to_be_false();
+    expect(parse_order("random").has_value()).to_be_true();
+    expect(parse_order("random:99").value()).to_equal(std::uint64_t{99});
+    expect([] { return parse_order("sideways").has_value(); }).template to_throw<std::invalid_argument>();
+    expect([] { return parse_order("random:").has_value(); }).template to_throw<std::invalid_argument>();
+  });
+});
+
+CPPSPEC_MAIN(order_spec);
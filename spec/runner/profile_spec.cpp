@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+using namespace std::chrono_literals;
+
+namespace {
+// Run a fresh copy of the spec, returning the profile it printed
+std::string run_profiled(std::size_t count, const std::shared_ptr<Formatters::BaseFormatter>& formatter) {
+  // clang-format off
+  Description spec("spec", $ {
+    it("is quick", _ {});
+    it("is slow", _ { std::this_thread::sleep_for(60ms); });
+    context("with slow hooks", _ {
+      before_all([] { std::this_thread::sleep_for(40ms); });
+      it("is slowish", _ { std::this_thread::sleep_for(20ms); });
+    });
+  });
+  // clang-format on
+
+  std::ostringstream profile;
+  SpecHelper::run_with(formatter, {spec}, [&](Runner& runner) { runner.set_profile(count, profile); });
+  return profile.str();
+}
+
+std::string run_profiled(std::size_t count) {
+  std::ostringstream out;
+  return run_profiled(count, std::make_shared<Formatters::Verbose>(out));
+}
+}  // namespace
+
+describe profile_spec("Runner --profile", $ {
+  it("lists the slowest examples first", _ {
+    std::string profile = run_profiled(2);
+    expect(profile.find("Slowest 2 example(s)") != std::string::npos).to_be_true();
+    expect(profile.find("spec is slow") < profile.find("spec with slow hooks is slowish")).to_be_true();
+    expect(profile.find("is quick") == std::string::npos).to_be_true();
+  });
+
+  it("splits a describe's time between its own hooks and its children", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      context("with slow hooks", _ {
+        before_all([] { std::this_thread::sleep_for(40ms); });
+        it("is slowish", _ { std::this_thread::sleep_for(20ms); });
+      });
+    });
+    // clang-format on
+    SpecHelper::run_specs({spec});
+
+    Profile profile{{&spec}, spec.get_runtime()};
+    auto groups = profile.slowest_groups(2);
+    auto hooks = std::ranges::find(groups, "spec with slow hooks", &Profile::Entry::description);
+    expect(hooks != groups.end()).to_be_true();
+    expect(hooks->own >= 40ms).to_be_true();
+    expect(hooks->total - hooks->own >= 20ms).to_be_true();
+    expect(hooks->total - hooks->own < 40ms).to_be_true();
+  });
+
+  it("only lists as many entries as there are", _ {
+    std::string profile = run_profiled(10);
+    expect(profile.find("Slowest 3 example(s)") != std::string::npos).to_be_true();
+    expect(profile.find("Slowest 2 describe(s)") != std::string::npos).to_be_true();
+  });
+
+  it("works with any formatter", _ {
+    std::ostringstream out;
+    std::string profile = run_profiled(1, std::make_shared<Formatters::JUnitXML>(out, false));
+    expect(profile.find("spec is slow") != std::string::npos).to_be_true();
+    expect(out.str().find("Slowest") == std::string::npos).to_be_true();
+  });
+
+  it("prints nothing unless asked to", _ { expect(run_profiled(0)).to_equal(""); });
+});
+
+CPPSPEC_MAIN(profile_spec);
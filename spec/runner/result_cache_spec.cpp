@@ -0,0 +1,94 @@
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+namespace {
+int examples_run = 0;
+bool broken = false;
+const std::string cache_file = (std::filesystem::temp_directory_path() / "cppspec_result_cache_spec").string();
+
+// Run a fresh copy of the spec with its results cached for build `build_id`
+std::string run_cached(std::uint64_t build_id, const std::function<void(Runner&)>& configure = [](Runner&) {}) {
+  // clang-format off
+  Description spec("spec", $ {
+    it("passes", _ { examples_run++; });
+    it(_ {
+      examples_run++;
+      expect(broken).to_be_false();
+    });
+    context("nested", _ {
+      it("passes too", _ { examples_run++; });
+    });
+  });
+  // clang-format on
+
+  auto run = SpecHelper::run_specs({spec}, [&](Runner& runner) {
+    runner.set_result_cache(cache_file, build_id);
+    configure(runner);
+  });
+  return run.output;
+}
+}  // namespace
+
+describe result_cache_spec("Runner --result-cache", $ {
+  before_each([] {
+    std::remove(cache_file.c_str());
+    examples_run = 0;
+    broken = false;
+  });
+
+  it("replays a passing run of the same build instead of running it", _ {
+    std::string output = run_cached(1);
+    expect(examples_run).to_equal(3);
+    expect(run_cached(1)).to_equal(output);
+    expect(examples_run).to_equal(3);
+  });
+
+  it("runs everything again for a different build", _ {
+    run_cached(1);
+    run_cached(2);
+    expect(examples_run).to_equal(6);
+  });
+
+  it("doesn't cache a run with failures", _ {
+    broken = true;
+    run_cached(1);
+    broken = false;
+    run_cached(1);
+    expect(examples_run).to_equal(6);
+  });
+
+  it("runs everything when a selected example isn't cached", _ {
+    run_cached(1, [](Runner& runner) { runner.add_example_filter("nested"); });
+    expect(examples_run).to_equal(1);
+    run_cached(1);
+    expect(examples_run).to_equal(4);
+    run_cached(1, [](Runner& runner) { runner.add_example_filter("passes"); });
+    expect(examples_run).to_equal(4);
+  });
+
+  it("identifies a build by the contents of its binary", _ {
+    std::string file = cache_file + ".bin";
+    std::FILE* out = std::fopen(file.c_str(), "wb");
+    std::fputs("one build", out);
+    std::fclose(out);
+    auto first = ResultCache::build_id(file);
+    out = std::fopen(file.c_str(), "wb");
+    std::fputs("another build", out);
+    std::fclose(out);
+    auto second = ResultCache::build_id(file);
+    std::remove(file.c_str());
+
+    expect(first.has_value()).to_be_true();
+    expect(*first == *second).to_be_false();
+    expect(ResultCache::build_id(file).has_value()).to_be_false();
+  });
+});
+
+CPPSPEC_MAIN(result_cache_spec);
@@ -0,0 +1,112 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+namespace {
+std::atomic<int> running = 0;
+std::atomic<int> most_running = 0;
+std::atomic<int> finished = 0;
+std::atomic<int> finished_before_after_all = -1;
+std::atomic<int> lets_made = 0;
+std::atomic<int> lets_shared = 0;
+
+// Keep an example busy for a moment, remembering how many ran alongside it
+void occupy() {
+  int now = ++running;
+  int most = most_running;
+  while (now > most && !most_running.compare_exchange_weak(most, now)) {
+  }
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+  while (most_running < 2 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  --running;
+  ++finished;
+}
+
+bool run_on(Description& spec, std::size_t jobs) {
+  return SpecHelper::run_specs({spec}, [=](Runner& runner) { runner.set_jobs(jobs); }).success;
+}
+}  // namespace
+
+describe scheduler_spec("Runner --jobs within a describe", $ {
+  before_each([] {
+    running = 0;
+    most_running = 0;
+    finished = 0;
+    finished_before_after_all = -1;
+    lets_made = 0;
+    lets_shared = 0;
+  });
+
+  it("runs the examples of a single describe concurrently", _ {
+    Description spec("one big describe", $ {
+      it("a", _ { occupy(); });
+      it("b", _ { occupy(); });
+      context("nested", _ {
+        it("c", _ { occupy(); });
+        it("d", _ { occupy(); });
+      });
+    });
+
+    run_on(spec, 4);
+    expect(finished.load()).to_equal(4);
+    expect(most_running.load()).to_be_greater_than(1);
+  });
+
+  it("runs the examples of a serial describe one at a time", _ {
+    Description spec("one big describe", $ {
+      self.serial();
+      it("a", _ { occupy(); });
+      it("b", _ { occupy(); });
+      context("nested", _ {
+        it("c", _ { occupy(); });
+        it("d", _ { occupy(); });
+      });
+    });
+
+    run_on(spec, 4);
+    expect(finished.load()).to_equal(4);
+    expect(most_running.load()).to_equal(1);
+  });
+
+  it("runs after_all once every example has finished", _ {
+    Description spec("one big describe", $ {
+      after_all([] { finished_before_after_all = finished.load(); });
+      it("a", _ { occupy(); });
+      it("b", _ { occupy(); });
+      it("c", _ { occupy(); });
+    });
+
+    run_on(spec, 4);
+    expect(finished_before_after_all.load()).to_equal(3);
+  });
+
+  it("gives every example its own let values", _ {
+    Description spec("lets", $ {
+      let(value, [] { return ++lets_made; });
+      for (int i = 0; i < 8; i++) {
+        it("memoizes within the example", _ {
+          int first = value.value();
+          std::this_thread::yield();
+          if (value.value() != first) {
+            lets_shared++;
+          }
+        });
+      }
+    });
+
+    expect(run_on(spec, 4)).to_be_true();
+    expect(lets_made.load()).to_equal(8);
+    expect(lets_shared.load()).to_equal(0);
+  });
+});
+
+CPPSPEC_MAIN(scheduler_spec);
@@ -0,0 +1,154 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+
+namespace {
+std::map<std::string, int> runs;
+int before_all_runs = 0;
+const std::string timings_file = (std::filesystem::temp_directory_path() / "cppspec_shard_spec_timings").string();
+
+// Run a fresh copy of the same specs as one shard out of `count`
+std::string run_shard(std::size_t index, std::size_t count, bool by_timings = false) {
+  // clang-format off
+  Description first("first", $ {
+    it("one", _ { runs["first one"]++; });
+    it("two", _ { runs["first two"]++; });
+    it("three", _ { runs["first three"]++; });
+    context("nested", _ {
+      before_all([] { before_all_runs++; });
+      it("four", _ { runs["first nested four"]++; });
+      it("five", _ { runs["first nested five"]++; });
+    });
+  });
+  Description second("second", $ {
+    it("six", _ { runs["second six"]++; });
+    it("seven", _ { runs["second seven"]++; });
+    it("eight", _ { runs["second eight"]++; });
+  });
+  // clang-format on
+
+  auto run = SpecHelper::run_specs({first, second}, [=](Runner& runner) {
+    runner.set_shard(index, count).set_timings_file(timings_file);
+    runner.set_shard_by_timings(by_timings);
+  });
+  return run.output;
+}
+
+// Pretend that every example recorded in the timings file took 1s, except those matching `slow`, which took 10s
+void rewrite_timings(const std::string& slow) {
+  auto timings = Runner::read_timings(timings_file);
+  std::ofstream file{timings_file, std::ios::trunc};
+  for (const auto& [id, seconds] : timings) {
+    file << (id.ends_with(slow) ? "10" : "1") << ' ' << id << '\n';
+  }
+}
+}  // namespace
+
+describe shard_spec("Runner --shard-index/--shard-count", $ {
+  before_each([] {
+    runs.clear();
+    before_all_runs = 0;
+  });
+
+  it("runs every example in exactly one shard", _ {
+    for (std::size_t index = 0; index < 3; index++) {
+      run_shard(index, 3);
+    }
+    expect(runs.size()).to_equal(std::size_t{8});
+    for (const auto& [name, count] : runs) {
+      expect(count).to_equal(1);
+    }
+  });
+
+  it("assigns examples to the same shard every time", _ {
+    std::string output = run_shard(1, 3);
+    expect(run_shard(1, 3)).to_equal(output);
+  });
+
+  it("only runs a context's before_all in shards that have its examples", _ {
+    int shards_with_nested = 0;
+    for (std::size_t index = 0; index < 4; index++) {
+      runs.clear();
+      run_shard(index, 4);
+      shards_with_nested += (runs.contains("first nested four") || runs.contains("first nested five")) ? 1 : 0;
+    }
+    expect(before_all_runs).to_equal(shards_with_nested);
+  });
+
+  it("runs everything with a single shard", _ {
+    run_shard(0, 1);
+    expect(runs.size()).to_equal(std::size_t{8});
+    expect(before_all_runs).to_equal(1);
+  });
+
+  context("by timings", _ {
+    before_each([] {
+      std::remove(timings_file.c_str());
+      for (std::size_t index = 0; index < 3; index++) {
+        std::remove((timings_file + ".shard-" + std::to_string(index)).c_str());
+      }
+    });
+
+    it("records the runtime of every example that ran", _ {
+      run_shard(0, 1);
+      expect(Runner::read_timings(timings_file).size()).to_equal(std::size_t{8});
+    });
+
+    it("leaves the timings file alone in a shard, and records its own runtimes separately", _ {
+      run_shard(0, 1);
+      rewrite_timings("first one");
+      runs.clear();
+      run_shard(1, 2, true);
+      expect(Runner::read_timings(timings_file + ".shard-1").size()).to_equal(runs.size());
+      expect(Runner::read_timings(timings_file).size()).to_equal(std::size_t{8});
+      for (const auto& [id, seconds] : Runner::read_timings(timings_file)) {
+        expect(seconds >= 1).to_be_true();
+      }
+    });
+
+    it("runs every example in exactly one shard", _ {
+      run_shard(0, 1);
+      runs.clear();
+      for (std::size_t index = 0; index < 3; index++) {
+        run_shard(index, 3, true);
+      }
+      expect(runs.size()).to_equal(std::size_t{8});
+      for (const auto& [name, count] : runs) {
+        expect(count).to_equal(1);
+      }
+    });
+
+    it("gives a slow example a shard of its own", _ {
+      run_shard(0, 1);
+      rewrite_timings("first nested four");
+      for (std::size_t index = 0; index < 2; index++) {
+        runs.clear();
+        run_shard(index, 2, true);
+        if (runs.contains("first nested four")) {
+          expect(runs.size()).to_equal(std::size_t{1});
+        }
+      }
+    });
+
+    it("hands out the longest jobs first, to the least loaded shard", _ {
+      auto shards = Runner::balance_shards({1, 4, 1, 1, 1}, 2);
+      expect(shards).to_equal(std::vector<std::size_t>{1, 0, 1, 1, 1});
+    });
+  });
+
+  it("rejects an index outside of the shard count", _ {
+    expect([] { return Runner{}.set_shard(2, 2).get_jobs(); }).template to_throw<std::out_of_range>();
+    expect([] { return Runner{}.set_shard(0, 0).get_jobs(); }).template to_throw<std::out_of_range>();
+  });
+});
+
+CPPSPEC_MAIN(shard_spec);
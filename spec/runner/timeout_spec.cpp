@@ -0,0 +1,155 @@
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+extern "C" {
+#include <sys/wait.h>
+#include <unistd.h>
+}
+#endif
+
+#include "cppspec.hpp"
+#include "spec_helper.hpp"
+
+using namespace CppSpec;
+using namespace std::chrono_literals;
+
+namespace {
+Result run_spec(Description& spec, const SpecHelper::Configure& configure = [](Runner&) {}) {
+  SpecHelper::run_specs({spec}, configure);
+  return spec.get_result();
+}
+
+// Run a spec under a RunControl of its own, as a Runner would. Without a
+// Runner there's no Watchdog, so slow examples can overrun their timeout by
+// however much a loaded machine makes them, without the run being given up on.
+Result run_timed(Description& spec, std::optional<RunControl::Seconds> default_timeout = std::nullopt) {
+  RunControl control;
+  control.default_timeout = default_timeout;
+  spec.set_run_control(&control);
+  spec.timed_run();
+  spec.set_run_control(nullptr);
+  return spec.get_result();
+}
+
+const ItBase& example(Description& spec, std::size_t index) {
+  auto child = spec.get_children().begin();
+  std::advance(child, index);
+  return static_cast<const ItBase&>(**child);
+}
+}  // namespace
+
+describe timeout_spec("Timeouts", $ {
+  it("reports an example that runs past its timeout as an error", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("is slow", _ { std::this_thread::sleep_for(50ms); }).timeout(10ms);
+      it("is fast", _ {}).timeout(10s);
+    });
+    // clang-format on
+    run_timed(spec);
+    expect(example(spec, 0).get_result().is_error()).to_be_true();
+    expect(example(spec, 0).get_result().get_message()).to_start_with("Timed out after");
+    expect(example(spec, 1).get_result().is_success()).to_be_true();
+  });
+
+  it("applies a describe's timeout to the examples inside it", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      self.timeout(10ms);
+      context("nested", _ {
+        it("is slow", _ { std::this_thread::sleep_for(50ms); });
+      });
+      it("has its own timeout", _ { std::this_thread::sleep_for(50ms); }).timeout(10s);
+    });
+    // clang-format on
+    run_timed(spec);
+    const auto& nested = static_cast<const Description&>(*spec.get_children().front());
+    expect(nested.get_result().is_error()).to_be_true();
+    expect(example(spec, 1).get_result().is_success()).to_be_true();
+  });
+
+  it("applies --timeout to examples without a timeout of their own", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("is slow", _ { std::this_thread::sleep_for(50ms); });
+    });
+    // clang-format on
+    expect(run_timed(spec, 10ms).is_error()).to_be_true();
+  });
+
+  it("leaves examples without a timeout alone", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("is slow", _ { std::this_thread::sleep_for(20ms); });
+    });
+    // clang-format on
+    expect(run_spec(spec).is_success()).to_be_true();
+  });
+
+#ifndef _WIN32
+  it("kills an isolated spec whose example hangs", _ {
+    // clang-format off
+    Description spec("spec", $ {
+      it("passes", _ {});
+      it("hangs", _ { std::this_thread::sleep_for(60s); }).timeout(100ms);
+      it("never starts", _ {});
+    });
+    // clang-format on
+    auto started = std::chrono::steady_clock::now();
+    auto run = SpecHelper::run_specs({spec}, [](Runner& runner) { runner.set_isolated(true); });
+    expect(std::chrono::steady_clock::now() - started < 30s).to_be_true();
+    expect(run.success).to_be_false();
+    expect(example(spec, 0).get_result().is_success()).to_be_true();
+    expect(example(spec, 1).get_result().get_message()).to_start_with("Timed out after");
+    expect(example(spec, 2).get_result().get_message()).to_start_with("Not run");
+  });
+
+  it("reports what ran before giving up on a hung example", _ {
+    // The Watchdog ends the process it gives up on, so give it one of its own
+    std::FILE* output = std::tmpfile();
+    std::cout.flush();
+    std::fflush(nullptr);
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      ::dup2(::fileno(output), STDOUT_FILENO);
+      ::dup2(::fileno(output), STDERR_FILENO);
+      // clang-format off
+      Description spec("spec", $ {
+        it("passes", _ {});
+        it("hangs", _ { std::this_thread::sleep_for(60s); }).timeout(100ms);
+        it("never starts", _ {});
+      });
+      // clang-format on
+      SpecHelper::run_with(std::make_shared<Formatters::TAP>(), {spec});
+      std::_Exit(EXIT_SUCCESS);  // Not reached: the Watchdog exits first
+    }
+
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    std::string report(4096, '\0');
+    std::rewind(output);
+    report.resize(std::fread(report.data(), 1, report.size(), output));
+    std::fclose(output);
+
+    expect(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_FAILURE).to_be_true();
+    expect(report.find("giving up on the run") != std::string::npos).to_be_true();
+    expect(report.find("1..2") != std::string::npos).to_be_true();
+    expect(report.find("ok 1 - passes") != std::string::npos).to_be_true();
+    expect(report.find("not ok 2 - hangs") != std::string::npos).to_be_true();
+    expect(report.find("Timed out after 0.1s") != std::string::npos).to_be_true();
+    expect(report.find("never starts") == std::string::npos).to_be_true();
+  });
+#endif
+});
+
+CPPSPEC_MAIN(timeout_spec);
@@ -0,0 +1,55 @@
+/**
+ * @file
+ * @brief Helpers shared by the specs that run specs of their own
+ */
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "cppspec.hpp"
+
+namespace SpecHelper {
+
+using Specs = std::initializer_list<std::reference_wrapper<CppSpec::Description>>;
+using Configure = std::function<void(CppSpec::Runner&)>;
+
+/**
+ * @brief What came of running some specs with run_specs
+ */
+struct Run {
+  bool success;
+  std::string output;  // What the Verbose formatter printed, without colors
+};
+
+/**
+ * @brief Run `specs` on a Runner that `configure` has set up, reporting them to `formatter`
+ * @return whether the run passed
+ */
+inline bool run_with(const std::shared_ptr<CppSpec::Formatters::BaseFormatter>& formatter,
+                     Specs specs,
+                     const Configure& configure = [](CppSpec::Runner&) {}) {
+  CppSpec::Runner runner{formatter};
+  for (CppSpec::Description& spec : specs) {
+    runner.add_spec(spec);
+  }
+  configure(runner);
+  return runner.run().is_success();
+}
+
+/**
+ * @brief Run `specs` on a Runner that `configure` has set up, reporting
+ * them to a Verbose formatter that writes to a string
+ */
+inline Run run_specs(Specs specs, const Configure& configure = [](CppSpec::Runner&) {}) {
+  std::ostringstream out;
+  auto formatter = std::make_shared<CppSpec::Formatters::Verbose>(out);
+  formatter->set_color_output(false);
+  bool success = run_with(formatter, specs, configure);
+  return {.success = success, .output = out.str()};
+}
+
+}  // namespace SpecHelper
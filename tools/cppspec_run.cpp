@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @brief cppspec-run: run every spec binary in parallel, with one merged
+ * progress display and one merged JUnit report
+ *
+ * Usage: cppspec-run [-j N] [--output-junit FILE] [PATH...] [-- SPEC ARGS...]
+ */
+#include <argparse/argparse.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "orchestrator.hpp"
+
+int main(int argc, char** argv) {
+  using namespace CppSpec;
+
+  // Everything after `--` is passed on to every spec binary
+  std::vector<std::string> spec_args;
+  int own_argc = argc;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string_view{argv[i]} == "--") {
+      spec_args.assign(argv + i + 1, argv + argc);
+      own_argc = i;
+      break;
+    }
+  }
+
+  argparse::ArgumentParser program{"cppspec-run"};
+  program.add_argument("paths")
+      .nargs(argparse::nargs_pattern::any)
+      .default_value(std::vector<std::string>{"."})
+      .help("spec binaries, or directories to search for *_spec binaries in");
+  program.add_argument("-j", "--jobs")
+      .default_value(std::size_t{0})
+      .scan<'u', std::size_t>()
+      .help("run up to N spec binaries at the same time (0 uses every hardware thread)");
+  program.add_argument("--output-junit")
+      .help("output the merged JUnit XML of every spec binary to the specified file")
+      .default_value(std::string{});
+
+  try {
+    program.parse_args(own_argc, argv);
+  } catch (const std::runtime_error& err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::filesystem::path> paths;
+  for (const std::string& path : program.get<std::vector<std::string>>("paths")) {
+    paths.emplace_back(path);
+  }
+  std::vector<Orchestrator::Binary> binaries;
+  try {
+    for (const auto& path : Orchestrator::find_spec_binaries(paths)) {
+      binaries.push_back({.path = path});
+    }
+  } catch (const std::exception& err) {
+    std::cerr << err.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (binaries.empty()) {
+    std::cerr << "No spec binaries found" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto jobs = program.get<std::size_t>("--jobs");
+  if (jobs == 0) {
+    jobs = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  Orchestrator::ProgressDisplay display;
+  auto started = std::chrono::steady_clock::now();
+  Orchestrator::run(binaries, jobs, spec_args, [&display](const Orchestrator::Binary& binary) {
+    display.format(binary);
+  });
+  display.summarize(binaries.size(), std::chrono::steady_clock::now() - started);
+
+  if (auto junit_output_filepath = program.get<std::string>("--output-junit"); !junit_output_filepath.empty()) {
+    std::ofstream file{junit_output_filepath};
+    file << std::fixed;  // disable scientific notation
+    file << Formatters::junit_xml_header << std::endl;
+    file << Orchestrator::to_junit(binaries, "cppspec-run").to_xml() << std::endl;
+  }
+
+  return Orchestrator::succeeded(binaries) ? EXIT_SUCCESS : EXIT_FAILURE;
+}